@@ -0,0 +1,930 @@
+/*
+
+Copyright (c) 2015 Harm Hanemaaijer <fgenfb@yahoo.com>
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+*/
+
+/*
+ * ASTC LDR decoder. Every footprint uses a 128-bit block; blocks that use HDR
+ * endpoint modes or are otherwise illegal decode to the error color (magenta),
+ * as required for LDR profile decoders.
+ */
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASTC_SSE2 1
+#include <emmintrin.h>
+#else
+#define ASTC_SSE2 0
+#endif
+
+#include "detex.h"
+#include "misc.h"
+
+#define ASTC_MAX_TEXELS 144
+#define ASTC_MAX_WEIGHTS 64
+#define ASTC_ERROR_COLOR 0xFFFF00FF
+
+enum {
+	ASTC_QUANT_2, ASTC_QUANT_3, ASTC_QUANT_4, ASTC_QUANT_5, ASTC_QUANT_6,
+	ASTC_QUANT_8, ASTC_QUANT_10, ASTC_QUANT_12, ASTC_QUANT_16, ASTC_QUANT_20,
+	ASTC_QUANT_24, ASTC_QUANT_32, ASTC_QUANT_40, ASTC_QUANT_48, ASTC_QUANT_64,
+	ASTC_QUANT_80, ASTC_QUANT_96, ASTC_QUANT_128, ASTC_QUANT_160, ASTC_QUANT_192,
+	ASTC_QUANT_256, ASTC_QUANT_COUNT
+};
+
+/* Number of trits, quints and plain bits for each quantization level. */
+static const uint8_t astc_quant_trits[ASTC_QUANT_COUNT] = {
+	0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0
+};
+static const uint8_t astc_quant_quints[ASTC_QUANT_COUNT] = {
+	0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0
+};
+static const uint8_t astc_quant_bits[ASTC_QUANT_COUNT] = {
+	1, 0, 2, 0, 1, 3, 1, 2, 4, 2, 3, 5, 3, 4, 6, 4, 5, 7, 5, 6, 8
+};
+
+/* 128-bit block stored as two little-endian 64-bit words. */
+typedef struct {
+	uint64_t lo;
+	uint64_t hi;
+} AstcBits;
+
+static DETEX_INLINE_ONLY uint32_t AstcReadBits(const AstcBits *block, int start, int count) {
+	if (count == 0)
+		return 0;
+	uint64_t value;
+	if (start >= 64)
+		value = block->hi >> (start - 64);
+	else if (start == 0)
+		value = block->lo;
+	else
+		value = (block->lo >> start) | (block->hi << (64 - start));
+	return (uint32_t)(value & ((1ull << count) - 1));
+}
+
+static DETEX_INLINE_ONLY uint64_t AstcReverse64(uint64_t v) {
+	v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+	v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+	v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+	v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+	v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+	return (v >> 32) | (v << 32);
+}
+
+static int AstcGetSequenceBitCount(int count, int quant) {
+	int bits = count * astc_quant_bits[quant];
+	if (astc_quant_trits[quant])
+		bits += (count * 8 + 4) / 5;
+	else if (astc_quant_quints[quant])
+		bits += (count * 7 + 2) / 3;
+	return bits;
+}
+
+/* Read bits from an integer sequence; bits past its end read as zero. */
+static DETEX_INLINE_ONLY uint32_t AstcReadSequenceBits(const AstcBits *block, int *bitpos,
+int end, int count) {
+	int start = *bitpos;
+	*bitpos += count;
+	if (start >= end)
+		return 0;
+	if (start + count > end)
+		count = end - start;
+	return AstcReadBits(block, start, count);
+}
+
+static void AstcDecodeTrits(uint32_t t, uint8_t *trits) {
+	uint32_t c;
+	if (((t >> 2) & 7) == 7) {
+		c = ((t >> 3) & 0x1C) | (t & 3);
+		trits[4] = 2;
+		trits[3] = 2;
+	}
+	else {
+		c = t & 0x1F;
+		if (((t >> 5) & 3) == 3) {
+			trits[4] = 2;
+			trits[3] = (t >> 7) & 1;
+		}
+		else {
+			trits[4] = (t >> 7) & 1;
+			trits[3] = (t >> 5) & 3;
+		}
+	}
+	if ((c & 3) == 3) {
+		trits[2] = 2;
+		trits[1] = (c >> 4) & 1;
+		trits[0] = (((c >> 3) & 1) << 1) | (((c >> 2) & 1) & ~((c >> 3) & 1));
+	}
+	else if (((c >> 2) & 3) == 3) {
+		trits[2] = 2;
+		trits[1] = 2;
+		trits[0] = c & 3;
+	}
+	else {
+		trits[2] = (c >> 4) & 1;
+		trits[1] = (c >> 2) & 3;
+		trits[0] = (((c >> 1) & 1) << 1) | ((c & 1) & ~((c >> 1) & 1));
+	}
+}
+
+static void AstcDecodeQuints(uint32_t q, uint8_t *quints) {
+	if (((q >> 1) & 3) == 3 && ((q >> 5) & 3) == 0) {
+		uint32_t q0 = q & 1;
+		quints[2] = (uint8_t)((q0 << 2) | ((((q >> 4) & 1) & ~q0 & 1) << 1) |
+			(((q >> 3) & 1) & ~q0 & 1));
+		quints[1] = 4;
+		quints[0] = 4;
+		return;
+	}
+	uint32_t c;
+	if (((q >> 1) & 3) == 3) {
+		quints[2] = 4;
+		c = (((q >> 3) & 3) << 3) | ((~(q >> 5) & 3) << 1) | (q & 1);
+	}
+	else {
+		quints[2] = (q >> 5) & 3;
+		c = q & 0x1F;
+	}
+	if ((c & 7) == 5) {
+		quints[1] = 4;
+		quints[0] = (c >> 3) & 3;
+	}
+	else {
+		quints[1] = (c >> 3) & 3;
+		quints[0] = c & 7;
+	}
+}
+
+/*
+ * Decode a bounded integer sequence. Each output value is split into its
+ * plain bits (low byte) and its trit/quint digit (high byte) so that the
+ * unquantization step can use either part.
+ */
+static void AstcDecodeSequence(const AstcBits *block, int start, int count, int quant,
+uint16_t *out) {
+	int nbits = astc_quant_bits[quant];
+	int end = start + AstcGetSequenceBitCount(count, quant);
+	int bitpos = start;
+	if (astc_quant_trits[quant]) {
+		static const int trit_bits[5] = { 2, 2, 1, 2, 1 };
+		for (int i = 0; i < count; i += 5) {
+			uint32_t m[5];
+			uint32_t t = 0;
+			int tpos = 0;
+			for (int j = 0; j < 5; j++) {
+				m[j] = AstcReadSequenceBits(block, &bitpos, end, nbits);
+				t |= AstcReadSequenceBits(block, &bitpos, end, trit_bits[j]) << tpos;
+				tpos += trit_bits[j];
+			}
+			uint8_t trits[5];
+			AstcDecodeTrits(t, trits);
+			for (int j = 0; j < 5 && i + j < count; j++)
+				out[i + j] = (uint16_t)(m[j] | (trits[j] << 8));
+		}
+	}
+	else if (astc_quant_quints[quant]) {
+		static const int quint_bits[3] = { 3, 2, 2 };
+		for (int i = 0; i < count; i += 3) {
+			uint32_t m[3];
+			uint32_t q = 0;
+			int qpos = 0;
+			for (int j = 0; j < 3; j++) {
+				m[j] = AstcReadSequenceBits(block, &bitpos, end, nbits);
+				q |= AstcReadSequenceBits(block, &bitpos, end, quint_bits[j]) << qpos;
+				qpos += quint_bits[j];
+			}
+			uint8_t quints[3];
+			AstcDecodeQuints(q, quints);
+			for (int j = 0; j < 3 && i + j < count; j++)
+				out[i + j] = (uint16_t)(m[j] | (quints[j] << 8));
+		}
+	}
+	else
+		for (int i = 0; i < count; i++)
+			out[i] = (uint16_t)AstcReadSequenceBits(block, &bitpos, end, nbits);
+}
+
+/* Replicate the low 'from' bits of value to fill 'to' bits. */
+static DETEX_INLINE_ONLY uint32_t AstcReplicate(uint32_t value, int from, int to) {
+	if (from == 0)
+		return 0;
+	uint32_t result = 0;
+	int shift = to - from;
+	while (shift > 0) {
+		result |= value << shift;
+		shift -= from;
+	}
+	return result | (value >> -shift);
+}
+
+/* Unquantize a color endpoint value to 0..255. */
+static uint32_t AstcUnquantizeColor(uint16_t value, int quant) {
+	int nbits = astc_quant_bits[quant];
+	uint32_t m = value & 0xFF;
+	if (!astc_quant_trits[quant] && !astc_quant_quints[quant])
+		return AstcReplicate(m, nbits, 8);
+	uint32_t digit = value >> 8;
+	uint32_t a = (m & 1) ? 0x1FF : 0;
+	uint32_t b = (m >> 1) & 1, c = (m >> 2) & 1, d = (m >> 3) & 1;
+	uint32_t e = (m >> 4) & 1, f = (m >> 5) & 1;
+	uint32_t B = 0, C = 0;
+	if (astc_quant_trits[quant]) {
+		switch (nbits) {
+		case 1: C = 204; break;
+		case 2: C = 93; B = (b << 8) | (b << 4) | (b << 2) | (b << 1); break;
+		case 3: C = 44; B = (c << 8) | (b << 7) | (c << 3) | (b << 2) | (c << 1) | b; break;
+		case 4: C = 22; B = (d << 8) | (c << 7) | (b << 6) | (d << 2) | (c << 1) | b; break;
+		case 5: C = 11; B = (e << 8) | (d << 7) | (c << 6) | (b << 5) | (e << 1) | d; break;
+		case 6: C = 5; B = (f << 8) | (e << 7) | (d << 6) | (c << 5) | (b << 4) | f; break;
+		}
+	}
+	else {
+		switch (nbits) {
+		case 1: C = 113; break;
+		case 2: C = 54; B = (b << 8) | (b << 3) | (b << 2); break;
+		case 3: C = 26; B = (c << 8) | (b << 7) | (c << 2) | (b << 1) | c; break;
+		case 4: C = 13; B = (d << 8) | (c << 7) | (b << 6) | (d << 1) | c; break;
+		case 5: C = 6; B = (e << 8) | (d << 7) | (c << 6) | (b << 5) | e; break;
+		}
+	}
+	uint32_t t = digit * C + B;
+	t ^= a;
+	return (a & 0x80) | (t >> 2);
+}
+
+/* Unquantize a weight value to 0..64. */
+static uint32_t AstcUnquantizeWeight(uint16_t value, int quant) {
+	int nbits = astc_quant_bits[quant];
+	uint32_t m = value & 0xFF;
+	uint32_t digit = value >> 8;
+	uint32_t t;
+	if (quant == ASTC_QUANT_3)
+		t = digit == 0 ? 0 : (digit == 1 ? 32 : 63);
+	else if (quant == ASTC_QUANT_5)
+		t = digit * 16 - (digit > 2);
+	else if (!astc_quant_trits[quant] && !astc_quant_quints[quant])
+		t = AstcReplicate(m, nbits, 6);
+	else {
+		uint32_t a = (m & 1) ? 0x7F : 0;
+		uint32_t b = (m >> 1) & 1, c = (m >> 2) & 1;
+		uint32_t B = 0, C = 0;
+		if (astc_quant_trits[quant]) {
+			switch (nbits) {
+			case 1: C = 50; break;
+			case 2: C = 23; B = (b << 6) | (b << 2) | b; break;
+			case 3: C = 11; B = (c << 6) | (b << 5) | (c << 1) | b; break;
+			}
+		}
+		else {
+			switch (nbits) {
+			case 1: C = 28; break;
+			case 2: C = 13; B = (b << 6) | (b << 1); break;
+			}
+		}
+		t = digit * C + B;
+		t ^= a;
+		t = (a & 0x20) | (t >> 2);
+	}
+	return t > 32 ? t + 1 : t;
+}
+
+static DETEX_INLINE_ONLY uint32_t AstcHash52(uint32_t p) {
+	p ^= p >> 15;
+	p -= p << 17;
+	p += p << 7;
+	p += p << 4;
+	p ^= p >> 5;
+	p += p << 16;
+	p ^= p >> 7;
+	p ^= p >> 3;
+	p ^= p << 6;
+	p ^= p >> 17;
+	return p;
+}
+
+/*
+ * Fill in the partition index of every texel of the block. The seed hash and
+ * the shift amounts only depend on the block, so they are worked out once.
+ */
+static void AstcComputePartitions(int seed, int partition_count, int block_width,
+int block_height, uint8_t * DETEX_RESTRICT partitions) {
+	const int texel_count = block_width * block_height;
+	if (partition_count == 1) {
+		memset(partitions, 0, texel_count);
+		return;
+	}
+	const int scale = texel_count < 31 ? 2 : 1;
+	seed += (partition_count - 1) * 1024;
+	uint32_t rnum = AstcHash52(seed);
+	uint8_t seeds[8];
+	for (int i = 0; i < 8; i++) {
+		uint8_t s = (rnum >> (i * 4)) & 0xF;
+		seeds[i] = s * s;
+	}
+	int sh1, sh2;
+	if (seed & 1) {
+		sh1 = (seed & 2) ? 4 : 5;
+		sh2 = partition_count == 3 ? 6 : 5;
+	}
+	else {
+		sh1 = partition_count == 3 ? 6 : 5;
+		sh2 = (seed & 2) ? 4 : 5;
+	}
+	const int ax = (seeds[0] >> sh1) * scale, ay = (seeds[1] >> sh2) * scale;
+	const int bx = (seeds[2] >> sh1) * scale, by = (seeds[3] >> sh2) * scale;
+	const int cx = (seeds[4] >> sh1) * scale, cy = (seeds[5] >> sh2) * scale;
+	const int dx = (seeds[6] >> sh1) * scale, dy = (seeds[7] >> sh2) * scale;
+	for (int y = 0; y < block_height; y++)
+		for (int x = 0; x < block_width; x++) {
+			int a = (ax * x + ay * y + (rnum >> 14)) & 0x3F;
+			int b = (bx * x + by * y + (rnum >> 10)) & 0x3F;
+			int c = (cx * x + cy * y + (rnum >> 6)) & 0x3F;
+			int d = (dx * x + dy * y + (rnum >> 2)) & 0x3F;
+			if (partition_count < 4)
+				d = 0;
+			if (partition_count < 3)
+				c = 0;
+			int partition;
+			if (a >= b && a >= c && a >= d)
+				partition = 0;
+			else if (b >= c && b >= d)
+				partition = 1;
+			else if (c >= d)
+				partition = 2;
+			else
+				partition = 3;
+			partitions[y * block_width + x] = (uint8_t)partition;
+		}
+}
+
+static DETEX_INLINE_ONLY void AstcBitTransferSigned(int *a, int *b) {
+	*b >>= 1;
+	*b |= *a & 0x80;
+	*a >>= 1;
+	*a &= 0x3F;
+	if (*a & 0x20)
+		*a -= 0x40;
+}
+
+static DETEX_INLINE_ONLY void AstcSetEndpoint(int *e, int r, int g, int b, int a) {
+	e[0] = detexClamp0To255(r);
+	e[1] = detexClamp0To255(g);
+	e[2] = detexClamp0To255(b);
+	e[3] = detexClamp0To255(a);
+}
+
+static DETEX_INLINE_ONLY void AstcSetEndpointBlueContract(int *e, int r, int g, int b, int a) {
+	AstcSetEndpoint(e, (r + b) >> 1, (g + b) >> 1, b, a);
+}
+
+/* Decode a pair of LDR endpoints. Returns false for HDR endpoint modes. */
+static bool AstcDecodeEndpoints(int mode, const uint32_t *values, int *e0, int *e1) {
+	int v[8];
+	for (int i = 0; i < ((mode >> 2) + 1) * 2; i++)
+		v[i] = values[i];
+	switch (mode) {
+	case 0:
+		AstcSetEndpoint(e0, v[0], v[0], v[0], 0xFF);
+		AstcSetEndpoint(e1, v[1], v[1], v[1], 0xFF);
+		return true;
+	case 1: {
+		int l0 = (v[0] >> 2) | (v[1] & 0xC0);
+		int l1 = l0 + (v[1] & 0x3F);
+		AstcSetEndpoint(e0, l0, l0, l0, 0xFF);
+		AstcSetEndpoint(e1, l1, l1, l1, 0xFF);
+		return true;
+	}
+	case 4:
+		AstcSetEndpoint(e0, v[0], v[0], v[0], v[2]);
+		AstcSetEndpoint(e1, v[1], v[1], v[1], v[3]);
+		return true;
+	case 5:
+		AstcBitTransferSigned(&v[1], &v[0]);
+		AstcBitTransferSigned(&v[3], &v[2]);
+		AstcSetEndpoint(e0, v[0], v[0], v[0], v[2]);
+		AstcSetEndpoint(e1, v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+		return true;
+	case 6:
+		AstcSetEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, 0xFF);
+		AstcSetEndpoint(e1, v[0], v[1], v[2], 0xFF);
+		return true;
+	case 8:
+		if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4]) {
+			AstcSetEndpoint(e0, v[0], v[2], v[4], 0xFF);
+			AstcSetEndpoint(e1, v[1], v[3], v[5], 0xFF);
+		}
+		else {
+			AstcSetEndpointBlueContract(e0, v[1], v[3], v[5], 0xFF);
+			AstcSetEndpointBlueContract(e1, v[0], v[2], v[4], 0xFF);
+		}
+		return true;
+	case 9:
+		AstcBitTransferSigned(&v[1], &v[0]);
+		AstcBitTransferSigned(&v[3], &v[2]);
+		AstcBitTransferSigned(&v[5], &v[4]);
+		if (v[1] + v[3] + v[5] >= 0) {
+			AstcSetEndpoint(e0, v[0], v[2], v[4], 0xFF);
+			AstcSetEndpoint(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], 0xFF);
+		}
+		else {
+			AstcSetEndpointBlueContract(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], 0xFF);
+			AstcSetEndpointBlueContract(e1, v[0], v[2], v[4], 0xFF);
+		}
+		return true;
+	case 10:
+		AstcSetEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, v[4]);
+		AstcSetEndpoint(e1, v[0], v[1], v[2], v[5]);
+		return true;
+	case 12:
+		if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4]) {
+			AstcSetEndpoint(e0, v[0], v[2], v[4], v[6]);
+			AstcSetEndpoint(e1, v[1], v[3], v[5], v[7]);
+		}
+		else {
+			AstcSetEndpointBlueContract(e0, v[1], v[3], v[5], v[7]);
+			AstcSetEndpointBlueContract(e1, v[0], v[2], v[4], v[6]);
+		}
+		return true;
+	case 13:
+		AstcBitTransferSigned(&v[1], &v[0]);
+		AstcBitTransferSigned(&v[3], &v[2]);
+		AstcBitTransferSigned(&v[5], &v[4]);
+		AstcBitTransferSigned(&v[7], &v[6]);
+		if (v[1] + v[3] + v[5] >= 0) {
+			AstcSetEndpoint(e0, v[0], v[2], v[4], v[6]);
+			AstcSetEndpoint(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+		}
+		else {
+			AstcSetEndpointBlueContract(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+			AstcSetEndpointBlueContract(e1, v[0], v[2], v[4], v[6]);
+		}
+		return true;
+	default:
+		/* HDR endpoint modes (2, 3, 7, 11, 14, 15). */
+		return false;
+	}
+}
+
+/*
+ * Decode the block mode field into the weight grid size, weight quantization
+ * level and dual plane flag. Returns false for reserved block modes.
+ */
+static bool AstcDecodeBlockMode(uint32_t mode, int *grid_width, int *grid_height,
+int *weight_quant, bool *dual_plane) {
+	uint32_t quant = (mode >> 4) & 1;
+	uint32_t h = (mode >> 9) & 1;
+	uint32_t d = (mode >> 10) & 1;
+	uint32_t a = (mode >> 5) & 3;
+	int x, y;
+	if (mode & 3) {
+		quant |= (mode & 3) << 1;
+		uint32_t b = (mode >> 7) & 3;
+		switch ((mode >> 2) & 3) {
+		case 0: x = b + 4; y = a + 2; break;
+		case 1: x = b + 8; y = a + 2; break;
+		case 2: x = a + 2; y = b + 8; break;
+		default:
+			b &= 1;
+			if (mode & 0x100) {
+				x = b + 2;
+				y = a + 2;
+			}
+			else {
+				x = a + 2;
+				y = b + 6;
+			}
+			break;
+		}
+	}
+	else {
+		quant |= ((mode >> 2) & 3) << 1;
+		if (((mode >> 2) & 3) == 0)
+			return false;
+		uint32_t b = (mode >> 9) & 3;
+		switch ((mode >> 7) & 3) {
+		case 0: x = 12; y = a + 2; break;
+		case 1: x = a + 2; y = 12; break;
+		case 2:
+			x = a + 6;
+			y = b + 6;
+			d = 0;
+			h = 0;
+			break;
+		default:
+			if (a == 0) {
+				x = 6;
+				y = 10;
+			}
+			else if (a == 1) {
+				x = 10;
+				y = 6;
+			}
+			else
+				return false;
+			break;
+		}
+	}
+	*grid_width = x;
+	*grid_height = y;
+	*weight_quant = (quant - 2) + 6 * h;
+	*dual_plane = d != 0;
+	return true;
+}
+
+#if ASTC_SSE2
+
+/*
+ * Interpolation works on one texel per 128-bit register, a 32-bit lane per
+ * channel. The endpoints of each partition are interleaved as 16-bit pairs
+ * (e0, e1) and the weights as (64 - w, w), so that _mm_madd_epi16 gives
+ * e0 * (64 - w) + e1 * w. Expanding the endpoints to 16 bits multiplies that
+ * sum by 257, after which the two shifts of the scalar formula are one.
+ */
+static DETEX_INLINE_ONLY void AstcLoadEndpoints(const int endpoints[4][2][4],
+int partition_count, __m128i *out) {
+	for (int p = 0; p < partition_count; p++) {
+		const int *e0 = endpoints[p][0];
+		const int *e1 = endpoints[p][1];
+		out[p] = _mm_setr_epi16((short)e0[0], (short)e1[0], (short)e0[1], (short)e1[1],
+			(short)e0[2], (short)e1[2], (short)e0[3], (short)e1[3]);
+	}
+}
+
+static DETEX_INLINE_ONLY uint32_t AstcWeightPair(uint32_t w) {
+	return (w << 16) | (64 - w);
+}
+
+static DETEX_INLINE_ONLY __m128i AstcInterpolateTexel(__m128i endpoints, __m128i weights) {
+	__m128i sum = _mm_madd_epi16(endpoints, weights);
+	sum = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(sum, 8), sum), _mm_set1_epi32(32));
+	return _mm_srli_epi32(sum, 14);
+}
+
+/* Packs four texels of 32-bit channels into four RGBA8 pixels. */
+static DETEX_INLINE_ONLY void AstcStore4(__m128i c0, __m128i c1, __m128i c2, __m128i c3,
+uint32_t *pixels) {
+	__m128i packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+	_mm_storeu_si128((__m128i *)pixels, packed);
+}
+
+static DETEX_INLINE_ONLY void AstcStore1(__m128i c, uint32_t *pixel) {
+	__m128i packed = _mm_packs_epi32(c, c);
+	*pixel = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+}
+
+static DETEX_INLINE_ONLY void AstcInterpolateSinglePlane(const int endpoints[4][2][4],
+int partition_count, const uint8_t * DETEX_RESTRICT partitions,
+const uint8_t * DETEX_RESTRICT weights, int texel_count, uint32_t * DETEX_RESTRICT pixels) {
+	__m128i e[4];
+	AstcLoadEndpoints(endpoints, partition_count, e);
+	int i = 0;
+	for (; i + 4 <= texel_count; i += 4) {
+		__m128i c0 = AstcInterpolateTexel(e[partitions[i]],
+			_mm_set1_epi32((int)AstcWeightPair(weights[i])));
+		__m128i c1 = AstcInterpolateTexel(e[partitions[i + 1]],
+			_mm_set1_epi32((int)AstcWeightPair(weights[i + 1])));
+		__m128i c2 = AstcInterpolateTexel(e[partitions[i + 2]],
+			_mm_set1_epi32((int)AstcWeightPair(weights[i + 2])));
+		__m128i c3 = AstcInterpolateTexel(e[partitions[i + 3]],
+			_mm_set1_epi32((int)AstcWeightPair(weights[i + 3])));
+		AstcStore4(c0, c1, c2, c3, pixels + i);
+	}
+	for (; i < texel_count; i++)
+		AstcStore1(AstcInterpolateTexel(e[partitions[i]],
+			_mm_set1_epi32((int)AstcWeightPair(weights[i]))), pixels + i);
+}
+
+/* The second plane feeds one channel; a per-lane mask picks its weight pair. */
+static DETEX_INLINE_ONLY void AstcInterpolateDualPlane(const int endpoints[4][2][4],
+int partition_count, const uint8_t * DETEX_RESTRICT partitions,
+const uint8_t weights[2][ASTC_MAX_TEXELS], int plane2_component, int texel_count,
+uint32_t * DETEX_RESTRICT pixels) {
+	__m128i e[4];
+	AstcLoadEndpoints(endpoints, partition_count, e);
+	const __m128i plane2_mask = _mm_setr_epi32(plane2_component == 0 ? -1 : 0,
+		plane2_component == 1 ? -1 : 0, plane2_component == 2 ? -1 : 0,
+		plane2_component == 3 ? -1 : 0);
+	for (int i = 0; i < texel_count; i++) {
+		__m128i w0 = _mm_set1_epi32((int)AstcWeightPair(weights[0][i]));
+		__m128i w1 = _mm_set1_epi32((int)AstcWeightPair(weights[1][i]));
+		__m128i w = _mm_or_si128(_mm_and_si128(plane2_mask, w1), _mm_andnot_si128(plane2_mask, w0));
+		AstcStore1(AstcInterpolateTexel(e[partitions[i]], w), pixels + i);
+	}
+}
+
+#else
+
+static DETEX_INLINE_ONLY uint32_t AstcInterpolateChannel(int e0, int e1, int w) {
+	int c0 = (e0 << 8) | e0;
+	int c1 = (e1 << 8) | e1;
+	return ((c0 * (64 - w) + c1 * w + 32) >> 6) >> 8;
+}
+
+static DETEX_INLINE_ONLY void AstcInterpolateSinglePlane(const int endpoints[4][2][4],
+int partition_count, const uint8_t * DETEX_RESTRICT partitions,
+const uint8_t * DETEX_RESTRICT weights, int texel_count, uint32_t * DETEX_RESTRICT pixels) {
+	for (int i = 0; i < texel_count; i++) {
+		const int *e0 = endpoints[partitions[i]][0];
+		const int *e1 = endpoints[partitions[i]][1];
+		int w = weights[i];
+		pixels[i] = detexPack32RGBA8(AstcInterpolateChannel(e0[0], e1[0], w),
+			AstcInterpolateChannel(e0[1], e1[1], w), AstcInterpolateChannel(e0[2], e1[2], w),
+			AstcInterpolateChannel(e0[3], e1[3], w));
+	}
+}
+
+static DETEX_INLINE_ONLY void AstcInterpolateDualPlane(const int endpoints[4][2][4],
+int partition_count, const uint8_t * DETEX_RESTRICT partitions,
+const uint8_t weights[2][ASTC_MAX_TEXELS], int plane2_component, int texel_count,
+uint32_t * DETEX_RESTRICT pixels) {
+	/* Which plane each channel takes its weight from, fixed for the block. */
+	int plane[4] = { 0, 0, 0, 0 };
+	plane[plane2_component] = 1;
+	for (int i = 0; i < texel_count; i++) {
+		const int *e0 = endpoints[partitions[i]][0];
+		const int *e1 = endpoints[partitions[i]][1];
+		uint32_t c[4];
+		for (int ch = 0; ch < 4; ch++)
+			c[ch] = AstcInterpolateChannel(e0[ch], e1[ch], weights[plane[ch]][i]);
+		pixels[i] = detexPack32RGBA8(c[0], c[1], c[2], c[3]);
+	}
+}
+
+#endif
+
+/*
+ * Core block decoder. Marked inline-only so that the fixed footprint entry
+ * points below get the weight infill and interpolation loops compiled with
+ * constant trip counts.
+ */
+static DETEX_INLINE_ONLY bool AstcDecodeBlock(const uint8_t * DETEX_RESTRICT bitstring,
+int block_width, int block_height, uint32_t * DETEX_RESTRICT pixels) {
+	const int texel_count = block_width * block_height;
+	AstcBits block;
+	memcpy(&block.lo, bitstring, 8);
+	memcpy(&block.hi, bitstring + 8, 8);
+	uint32_t mode = AstcReadBits(&block, 0, 11);
+
+	/* Void-extent block: a single constant color. */
+	if ((mode & 0x1FF) == 0x1FC) {
+		if ((mode & 0x200) || AstcReadBits(&block, 10, 2) != 3)
+			goto error;
+		uint32_t color = detexPack32RGBA8(
+			AstcReadBits(&block, 64, 16) >> 8, AstcReadBits(&block, 80, 16) >> 8,
+			AstcReadBits(&block, 96, 16) >> 8, AstcReadBits(&block, 112, 16) >> 8);
+		for (int i = 0; i < texel_count; i++)
+			pixels[i] = color;
+		return true;
+	}
+
+	{
+	int grid_width, grid_height, weight_quant;
+	bool dual_plane;
+	if (!AstcDecodeBlockMode(mode, &grid_width, &grid_height, &weight_quant, &dual_plane))
+		goto error;
+	if (grid_width > block_width || grid_height > block_height)
+		goto error;
+	int planes = dual_plane ? 2 : 1;
+	int weight_count = grid_width * grid_height * planes;
+	int weight_bits = AstcGetSequenceBitCount(weight_count, weight_quant);
+	if (weight_count > ASTC_MAX_WEIGHTS || weight_bits < 24 || weight_bits > 96)
+		goto error;
+
+	int partition_count = AstcReadBits(&block, 11, 2) + 1;
+	if (partition_count == 4 && dual_plane)
+		goto error;
+
+	/* Color endpoint modes. */
+	int below_weights = 128 - weight_bits;
+	int cem[4];
+	int color_start;
+	int partition_seed = 0;
+	int cem_high_bits = 0;
+	if (partition_count == 1) {
+		cem[0] = AstcReadBits(&block, 13, 4);
+		color_start = 17;
+	}
+	else {
+		partition_seed = AstcReadBits(&block, 13, 10);
+		uint32_t cem_bits = AstcReadBits(&block, 23, 6);
+		color_start = 29;
+		if ((cem_bits & 3) == 0) {
+			for (int i = 0; i < partition_count; i++)
+				cem[i] = cem_bits >> 2;
+		}
+		else {
+			cem_high_bits = 3 * partition_count - 4;
+			below_weights -= cem_high_bits;
+			cem_bits |= AstcReadBits(&block, below_weights, cem_high_bits) << 6;
+			int base_class = (cem_bits & 3) - 1;
+			int bitpos = 2;
+			for (int i = 0; i < partition_count; i++, bitpos++)
+				cem[i] = (((cem_bits >> bitpos) & 1) + base_class) << 2;
+			for (int i = 0; i < partition_count; i++, bitpos += 2)
+				cem[i] |= (cem_bits >> bitpos) & 3;
+		}
+	}
+	int plane2_component = -1;
+	if (dual_plane) {
+		below_weights -= 2;
+		plane2_component = AstcReadBits(&block, below_weights, 2);
+	}
+
+	/* Color endpoint values. */
+	int color_value_count = 0;
+	for (int i = 0; i < partition_count; i++)
+		color_value_count += ((cem[i] >> 2) + 1) * 2;
+	if (color_value_count > 18)
+		goto error;
+	int color_bits = below_weights - color_start;
+	int color_quant = -1;
+	for (int q = ASTC_QUANT_256; q >= ASTC_QUANT_6; q--)
+		if (AstcGetSequenceBitCount(color_value_count, q) <= color_bits) {
+			color_quant = q;
+			break;
+		}
+	if (color_quant < 0)
+		goto error;
+	uint16_t color_values[18];
+	AstcDecodeSequence(&block, color_start, color_value_count, color_quant, color_values);
+	int endpoints[4][2][4];
+	uint32_t unquantized[18];
+	for (int i = 0; i < color_value_count; i++)
+		unquantized[i] = AstcUnquantizeColor(color_values[i], color_quant);
+	for (int i = 0, offset = 0; i < partition_count; i++) {
+		if (!AstcDecodeEndpoints(cem[i], unquantized + offset, endpoints[i][0], endpoints[i][1]))
+			goto error;
+		offset += ((cem[i] >> 2) + 1) * 2;
+	}
+
+	/* Weights are stored bit-reversed from the top of the block. */
+	AstcBits reversed;
+	reversed.lo = AstcReverse64(block.hi);
+	reversed.hi = AstcReverse64(block.lo);
+	uint16_t weight_values[ASTC_MAX_WEIGHTS];
+	AstcDecodeSequence(&reversed, 0, weight_count, weight_quant, weight_values);
+	/* Padded so that the infill may read one past the grid edge. */
+	uint8_t grid[2][ASTC_MAX_WEIGHTS + 16];
+	memset(grid, 0, sizeof(grid));
+	for (int i = 0; i < weight_count; i++)
+		grid[i % planes][i / planes] = (uint8_t)AstcUnquantizeWeight(weight_values[i], weight_quant);
+
+	/* Bilinear infill of the weight grid to the block footprint. */
+	uint8_t weights[2][ASTC_MAX_TEXELS];
+	const int ds = (1024 + block_width / 2) / (block_width - 1);
+	const int dt = (1024 + block_height / 2) / (block_height - 1);
+	for (int t = 0; t < block_height; t++)
+		for (int s = 0; s < block_width; s++) {
+			int gs = (ds * s * (grid_width - 1) + 32) >> 6;
+			int gt = (dt * t * (grid_height - 1) + 32) >> 6;
+			int fs = gs & 0xF;
+			int ft = gt & 0xF;
+			int v0 = (gs >> 4) + (gt >> 4) * grid_width;
+			int w11 = (fs * ft + 8) >> 4;
+			int w10 = ft - w11;
+			int w01 = fs - w11;
+			int w00 = 16 - fs - ft + w11;
+			for (int p = 0; p < planes; p++) {
+				const uint8_t *g = grid[p];
+				weights[p][t * block_width + s] = (uint8_t)((g[v0] * w00 +
+					g[v0 + 1] * w01 + g[v0 + grid_width] * w10 +
+					g[v0 + grid_width + 1] * w11 + 8) >> 4);
+			}
+		}
+
+	/* Interpolate the endpoints. */
+	uint8_t partitions[ASTC_MAX_TEXELS];
+	AstcComputePartitions(partition_seed, partition_count, block_width, block_height, partitions);
+	if (dual_plane)
+		AstcInterpolateDualPlane(endpoints, partition_count, partitions, weights,
+			plane2_component, texel_count, pixels);
+	else
+		AstcInterpolateSinglePlane(endpoints, partition_count, partitions, weights[0],
+			texel_count, pixels);
+	return true;
+	}
+
+error:
+	for (int i = 0; i < texel_count; i++)
+		pixels[i] = ASTC_ERROR_COLOR;
+	return false;
+}
+
+static bool AstcDecodeBlock4x4(const uint8_t * DETEX_RESTRICT bitstring,
+uint32_t * DETEX_RESTRICT pixels) {
+	return AstcDecodeBlock(bitstring, 4, 4, pixels);
+}
+
+static bool AstcDecodeBlock6x6(const uint8_t * DETEX_RESTRICT bitstring,
+uint32_t * DETEX_RESTRICT pixels) {
+	return AstcDecodeBlock(bitstring, 6, 6, pixels);
+}
+
+/* Decompress a 128-bit ASTC block of the given footprint into RGBA8 pixels. */
+bool detexDecompressBlockASTC(const uint8_t * DETEX_RESTRICT bitstring, uint32_t block_width,
+uint32_t block_height, uint8_t * DETEX_RESTRICT pixel_buffer) {
+	if (block_width < 4 || block_height < 4 || block_width * block_height > ASTC_MAX_TEXELS) {
+		detexSetErrorMessage("detexDecompressBlockASTC: Unsupported block footprint %dx%d",
+			block_width, block_height);
+		return false;
+	}
+	uint32_t pixels[ASTC_MAX_TEXELS];
+	bool r;
+	if (block_width == 4 && block_height == 4)
+		r = AstcDecodeBlock4x4(bitstring, pixels);
+	else if (block_width == 6 && block_height == 6)
+		r = AstcDecodeBlock6x6(bitstring, pixels);
+	else
+		r = AstcDecodeBlock(bitstring, block_width, block_height, pixels);
+	memcpy(pixel_buffer, pixels, block_width * block_height * 4);
+	return r;
+}
+
+/* Decompress a 128-bit 4x4 pixel texture block compressed using the ASTC */
+/* 4x4 format. */
+bool detexDecompressBlockASTC_4X4(const uint8_t * DETEX_RESTRICT bitstring, uint32_t mode_mask,
+uint32_t flags, uint8_t * DETEX_RESTRICT pixel_buffer) {
+	uint32_t pixels[16];
+	bool r = AstcDecodeBlock4x4(bitstring, pixels);
+	memcpy(pixel_buffer, pixels, sizeof(pixels));
+	return r;
+}
+
+/*
+ * Decode an ASTC texture into a single linear image buffer. Blocks are decoded
+ * with the fixed footprint decoder where one exists, converted into the target
+ * pixel format (a red/blue swap at most) and stored row by row.
+ */
+bool detexDecompressTextureLinearASTC(const detexTexture *texture, uint32_t block_width,
+uint32_t block_height, uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format) {
+	bool swap_red_blue;
+	switch (pixel_format) {
+	case DETEX_PIXEL_FORMAT_RGBA8:
+	case DETEX_PIXEL_FORMAT_RGBX8:
+		swap_red_blue = false;
+		break;
+	case DETEX_PIXEL_FORMAT_BGRA8:
+	case DETEX_PIXEL_FORMAT_BGRX8:
+		swap_red_blue = true;
+		break;
+	default:
+		detexSetErrorMessage("detexDecompressTextureLinearASTC: Unsupported pixel format");
+		return false;
+	}
+	if (block_width < 4 || block_height < 4 || block_width * block_height > ASTC_MAX_TEXELS) {
+		detexSetErrorMessage("detexDecompressTextureLinearASTC: Unsupported block footprint %dx%d",
+			block_width, block_height);
+		return false;
+	}
+	const uint8_t *data = texture->data;
+	const int row_pitch = texture->width * 4;
+	uint32_t pixels[ASTC_MAX_TEXELS];
+	bool result = true;
+	for (int y = 0; y < texture->height_in_blocks; y++) {
+		int nu_rows = texture->height - y * (int)block_height;
+		if (nu_rows > (int)block_height)
+			nu_rows = block_height;
+		for (int x = 0; x < texture->width_in_blocks; x++) {
+			bool r;
+			if (block_width == 4 && block_height == 4)
+				r = AstcDecodeBlock4x4(data, pixels);
+			else if (block_width == 6 && block_height == 6)
+				r = AstcDecodeBlock6x6(data, pixels);
+			else
+				r = AstcDecodeBlock(data, block_width, block_height, pixels);
+			if (!r)
+				result = false;
+			if (swap_red_blue)
+				for (uint32_t i = 0; i < block_width * block_height; i++) {
+					uint32_t pixel = pixels[i];
+					pixels[i] = detexPack32RGBA8(detexPixel32GetB8(pixel),
+						detexPixel32GetG8(pixel), detexPixel32GetR8(pixel),
+						detexPixel32GetA8(pixel));
+				}
+			int nu_columns = texture->width - x * (int)block_width;
+			if (nu_columns > (int)block_width)
+				nu_columns = block_width;
+			uint8_t *pixelp = pixel_buffer + y * block_height * row_pitch +
+				x * block_width * 4;
+			for (int row = 0; row < nu_rows; row++)
+				memcpy(pixelp + row * row_pitch, pixels + row * block_width,
+					nu_columns * 4);
+			data += 16;
+		}
+	}
+	return result;
+}
@@ -494,6 +494,16 @@ DETEX_API bool detexDecompressBlockEAC_RG11(const uint8_t *bitstring, uint32_t m
 DETEX_API bool detexDecompressBlockEAC_SIGNED_RG11(const uint8_t *bitstring,
 	uint32_t mode_mask, uint32_t flags, uint8_t *pixel_buffer);
 
+/* Decompress a 128-bit ASTC (LDR profile) texture block with the given */
+/* footprint into block_width * block_height RGBA8 pixels. HDR and illegal */
+/* blocks decode to magenta and return false. */
+DETEX_API bool detexDecompressBlockASTC(const uint8_t *bitstring, uint32_t block_width,
+	uint32_t block_height, uint8_t *pixel_buffer);
+/* Decompress a 128-bit 4x4 pixel texture block compressed using the ASTC */
+/* 4x4 format. */
+DETEX_API bool detexDecompressBlockASTC_4X4(const uint8_t *bitstring, uint32_t mode_mask,
+	uint32_t flags, uint8_t *pixel_buffer);
+
 /*
  * Decompression functions for 16-bit half-float formats. The output format is
  * DETEX_PIXEL_FORMAT_FLOAT_RGBX16 or DETEX_PIXEL_FORMAT_SIGNED_FLOAT_RGBX16.
@@ -744,6 +754,15 @@ DETEX_API bool detexDecompressTextureTiled(const detexTexture *texture, uint8_t
 DETEX_API bool detexDecompressTextureLinear(const detexTexture *texture, uint8_t *pixel_buffer,
 	uint32_t pixel_format);
 
+/*
+ * Decode an ASTC texture with an arbitrary block footprint (linear). The
+ * texture width_in_blocks and height_in_blocks count footprint-sized blocks.
+ * Supported pixel formats are RGBA8, RGBX8, BGRA8 and BGRX8.
+ */
+DETEX_API bool detexDecompressTextureLinearASTC(const detexTexture *texture,
+	uint32_t block_width, uint32_t block_height, uint8_t *pixel_buffer,
+	uint32_t pixel_format);
+
 
 /*
  * Miscellaneous functions.
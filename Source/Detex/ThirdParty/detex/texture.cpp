@@ -41,10 +41,11 @@ static detexDecompressBlockFuncType decompress_function[] = {
 	detexDecompressBlockETC2,
 	detexDecompressBlockETC2_PUNCHTHROUGH,
 	detexDecompressBlockETC2_EAC,
-	NULL, // detexDecompressBlockEAC_R11,
+	detexDecompressBlockEAC_R11,
 	NULL, // detexDecompressBlockEAC_SIGNED_R11,
-	NULL, // detexDecompressBlockEAC_RG11,
+	detexDecompressBlockEAC_RG11,
 	NULL, // detexDecompressBlockEAC_SIGNED_RG11,
+	detexDecompressBlockASTC_4X4,
 };
 
 /*
@@ -97,6 +98,120 @@ uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format) {
 	return result;
 }
 
+/* Swap the red and blue components of a decoded 4x4 block of 32-bit pixels. */
+static DETEX_INLINE_ONLY void SwapRedBlueBlock32(uint32_t * DETEX_RESTRICT block) {
+	for (int i = 0; i < 16; i++) {
+		uint32_t pixel = block[i];
+		block[i] = detexPack32RGBA8(
+			detexPixel32GetB8(pixel),
+			detexPixel32GetG8(pixel),
+			detexPixel32GetR8(pixel),
+			detexPixel32GetA8(pixel)
+			);
+	}
+}
+
+/*
+ * Linear decode loop specialized for a single compressed format that decodes
+ * into 32-bit pixels. The block decoder, compressed block size and pixel size
+ * are compile-time constants, and the conversion into the requested pixel
+ * format is reduced to an optional red/blue swap. Interior blocks are stored
+ * with fixed-size row copies straight into the destination; only the blocks on
+ * the right and bottom edges go through the variable-width copy.
+ */
+template <detexDecompressBlockFuncType decompress, uint32_t texture_format,
+bool swap_red_blue>
+static bool DecompressTextureLinear32(const detexTexture *texture,
+uint8_t * DETEX_RESTRICT pixel_buffer) {
+	const uint32_t compressed_block_size = detexGetCompressedBlockSize(texture_format);
+	const int row_pitch = texture->width * 4;
+	const int full_columns = texture->width / 4;
+	const int full_rows = texture->height / 4;
+	uint32_t block_buffer[16];
+	const uint8_t *data = texture->data;
+	bool result = true;
+	for (int y = 0; y < texture->height_in_blocks; y++) {
+		uint8_t *row_pixelp = pixel_buffer + y * 4 * row_pitch;
+		int nu_rows = y < full_rows ? 4 : texture->height - y * 4;
+		for (int x = 0; x < texture->width_in_blocks; x++) {
+			if (!decompress(data, DETEX_MODE_MASK_ALL, 0, (uint8_t *)block_buffer)) {
+				result = false;
+				memset(block_buffer, 0, sizeof(block_buffer));
+			}
+			else if (swap_red_blue)
+				SwapRedBlueBlock32(block_buffer);
+			uint8_t *pixelp = row_pixelp + x * 16;
+			if (x < full_columns && nu_rows == 4) {
+				memcpy(pixelp, &block_buffer[0], 16);
+				memcpy(pixelp + row_pitch, &block_buffer[4], 16);
+				memcpy(pixelp + row_pitch * 2, &block_buffer[8], 16);
+				memcpy(pixelp + row_pitch * 3, &block_buffer[12], 16);
+			}
+			else {
+				int nu_columns = x < full_columns ? 4 : texture->width - x * 4;
+				for (int row = 0; row < nu_rows; row++)
+					memcpy(pixelp + row * row_pitch, &block_buffer[row * 4],
+						nu_columns * 4);
+			}
+			data += compressed_block_size;
+		}
+	}
+	return result;
+}
+
+/*
+ * Pick the specialized loop for a 32-bit target pixel format. Decoders emit
+ * alpha 0xFF for RGBX8 formats, so RGBA8 and RGBX8 are interchangeable here.
+ * Returns false if the pair is not handled by a specialized loop.
+ */
+template <detexDecompressBlockFuncType decompress, uint32_t texture_format>
+static bool DispatchTextureLinear32(const detexTexture *texture,
+uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format, bool *result) {
+	switch (pixel_format) {
+	case DETEX_PIXEL_FORMAT_RGBA8:
+	case DETEX_PIXEL_FORMAT_RGBX8:
+		*result = DecompressTextureLinear32<decompress, texture_format, false>(texture,
+			pixel_buffer);
+		return true;
+	case DETEX_PIXEL_FORMAT_BGRA8:
+	case DETEX_PIXEL_FORMAT_BGRX8:
+		*result = DecompressTextureLinear32<decompress, texture_format, true>(texture,
+			pixel_buffer);
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool DecompressTextureLinearSpecialized(const detexTexture *texture,
+uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format, bool *result) {
+	switch (texture->format) {
+	case DETEX_TEXTURE_FORMAT_BC3:
+		return DispatchTextureLinear32<detexDecompressBlockBC3,
+			DETEX_TEXTURE_FORMAT_BC3>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_BPTC:
+		return DispatchTextureLinear32<detexDecompressBlockBPTC,
+			DETEX_TEXTURE_FORMAT_BPTC>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_ETC1:
+		return DispatchTextureLinear32<detexDecompressBlockETC1,
+			DETEX_TEXTURE_FORMAT_ETC1>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_ETC2:
+		return DispatchTextureLinear32<detexDecompressBlockETC2,
+			DETEX_TEXTURE_FORMAT_ETC2>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_ETC2_PUNCHTHROUGH:
+		return DispatchTextureLinear32<detexDecompressBlockETC2_PUNCHTHROUGH,
+			DETEX_TEXTURE_FORMAT_ETC2_PUNCHTHROUGH>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_ETC2_EAC:
+		return DispatchTextureLinear32<detexDecompressBlockETC2_EAC,
+			DETEX_TEXTURE_FORMAT_ETC2_EAC>(texture, pixel_buffer, pixel_format, result);
+	case DETEX_TEXTURE_FORMAT_ASTC_4X4:
+		return DispatchTextureLinear32<detexDecompressBlockASTC_4X4,
+			DETEX_TEXTURE_FORMAT_ASTC_4X4>(texture, pixel_buffer, pixel_format, result);
+	default:
+		return false;
+	}
+}
+
 /*
  * Decode texture function (linear). Decode an entire texture into a single
  * image buffer, with pixels stored row-by-row, converting into the given pixel
@@ -109,9 +224,13 @@ uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format) {
 		return detexConvertPixels(texture->data, texture->width * texture->height,
 			detexGetPixelFormat(texture->format), pixel_buffer, pixel_format);
 	}
+	bool result = true;
+	if (DecompressTextureLinearSpecialized(texture, pixel_buffer, pixel_format, &result))
+		return result;
 	const uint8_t *data = texture->data;
 	int pixel_size = detexGetPixelSize(pixel_format);
-	bool result = true;
+	uint32_t block_size = pixel_size * 16;
+	uint32_t compressed_block_size = detexGetCompressedBlockSize(texture->format);
 	for (int y = 0; y < texture->height_in_blocks; y++) {
 		int nu_rows;
 		if (y * 4 + 3 >= texture->height)
@@ -121,7 +240,6 @@ uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format) {
 		for (int x = 0; x < texture->width_in_blocks; x++) {
 			bool r = detexDecompressBlock(data, texture->format,
 				DETEX_MODE_MASK_ALL, 0, block_buffer, pixel_format);
-			uint32_t block_size = detexGetPixelSize(pixel_format) * 16;
 			if (!r) {
 				result = false;
 				memset(block_buffer, 0, block_size);
@@ -138,7 +256,7 @@ uint8_t * DETEX_RESTRICT pixel_buffer, uint32_t pixel_format) {
 				memcpy(pixelp + row * texture->width * pixel_size,
 					block_buffer + row * 4 * pixel_size,
 					nu_columns * pixel_size);
-			data += detexGetCompressedBlockSize(texture->format);
+			data += compressed_block_size;
 		}
 	}
 	return result;
@@ -46,6 +46,7 @@ public class JsonAsAsset : ModuleRules
 			"AssetTools",
 			"EditorStyle",
 			"Settings",
+			"DirectoryWatcher",
 			"PhysicsCore",
 			"MessageLog",
 			"PluginUtils",
@@ -0,0 +1,573 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Commandlets/JsonAsAssetImportCommandlet.h"
+
+#include "Importers/Constructor/Importer.h"
+#include "Importers/Constructor/ImportPipeline.h"
+#include "Settings/JsonAsAssetSettings.h"
+#include "Utilities/JsonAssetCreationQueue.h"
+#include "Utilities/JsonExportManifest.h"
+#include "Utilities/JsonImportReferences.h"
+#include "Utilities/JsonReferenceCache.h"
+#include "Utilities/JsonPackageSaveQueue.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace {
+	/* Imports waves of files in order, the report holds totals and a result per file */
+	TSharedRef<FJsonObject> ImportWaves(const TArray<TArray<FString>>& Waves, const int32 Threads, const bool bSave) {
+		TArray<FString> SortedFiles;
+
+		for (const TArray<FString>& Wave : Waves) {
+			SortedFiles.Append(Wave);
+		}
+
+		UJsonAsAssetSettings* Settings = GetMutableDefault<UJsonAsAssetSettings>();
+
+		/* Packages are queued as they're imported and saved together after each wave */
+		const bool bSavePackagesOnImport = Settings->AssetSettings.bSavePackagesOnImport;
+		Settings->AssetSettings.bSavePackagesOnImport = bSave;
+
+		FJsonPackageSaveQueue& SaveQueue = FJsonPackageSaveQueue::Get();
+		SaveQueue.BeginSession();
+
+		/* Registry notifications too, there's nobody watching them until the end */
+		FJsonAssetCreationQueue& CreationQueue = FJsonAssetCreationQueue::Get();
+		CreationQueue.BeginSession();
+
+		/* Assets are held per wave, garbage can be collected between them. Nothing else collects it in a commandlet */
+		IConsoleVariable* GCBetweenWaves = IConsoleManager::Get().FindConsoleVariable(TEXT("JsonAsAsset.GCBetweenWaves"));
+
+		if (GCBetweenWaves != nullptr && (GCBetweenWaves->GetFlags() & ECVF_SetByMask) == ECVF_SetByConstructor) {
+			GCBetweenWaves->Set(500, ECVF_SetByCode);
+		}
+
+		FJsonImportReferences& References = FJsonImportReferences::Get();
+		References.BeginSession();
+
+		/* References are resolved once per run, misses included */
+		FJsonReferenceCache& ReferenceCache = FJsonReferenceCache::Get();
+		ReferenceCache.BeginSession();
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		FJsonImportPipeline& Pipeline = FJsonImportPipeline::Get();
+
+		const int32 PrefetchWindow = Threads * 2;
+		Pipeline.Prepare(TArray<FString>(SortedFiles.GetData(), FMath::Min(PrefetchWindow, SortedFiles.Num())), false);
+
+		TArray<TSharedPtr<FJsonValue>> Results;
+		int32 NumFailed = 0;
+
+		int32 WaveIndex = 0;
+		int32 WaveEnd = Waves.Num() > 0 ? Waves[0].Num() : 0;
+
+		for (int32 Index = 0; Index < SortedFiles.Num(); Index++) {
+			if (SortedFiles.IsValidIndex(Index + PrefetchWindow)) {
+				Pipeline.Prepare({ SortedFiles[Index + PrefetchWindow] }, false);
+			}
+
+			const FString& File = SortedFiles[Index];
+			const double FileStartTime = FPlatformTime::Seconds();
+
+			const IImporter Importer;
+			const bool bImported = Importer.ImportReference(File);
+
+			const double Seconds = FPlatformTime::Seconds() - FileStartTime;
+
+			if (!bImported) NumFailed++;
+
+			UE_LOG(LogJson, Display, TEXT("[%d/%d] %s %s (%.2f s)"), Index + 1, SortedFiles.Num(), bImported ? TEXT("Imported") : TEXT("Failed"), *File, Seconds);
+
+			const TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+			Result->SetStringField(TEXT("File"), File);
+			Result->SetBoolField(TEXT("Success"), bImported);
+			Result->SetNumberField(TEXT("Seconds"), Seconds);
+
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+
+			if (Index + 1 == WaveEnd) {
+				References.FinishWave(Waves[WaveIndex].Num());
+
+				if (Waves.IsValidIndex(++WaveIndex)) {
+					WaveEnd += Waves[WaveIndex].Num();
+				}
+			}
+		}
+
+		Pipeline.Reset();
+		ReferenceCache.EndSession();
+		References.EndSession();
+		CreationQueue.EndSession();
+
+		const double ImportSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const FJsonPackageSaveReport SaveReport = SaveQueue.EndSession();
+		FJsonPackageSaveQueue::LogReport(SaveReport);
+
+		Settings->AssetSettings.bSavePackagesOnImport = bSavePackagesOnImport;
+
+		bool bSaved = SaveReport.NumFailed == 0;
+		double SaveSeconds = SaveReport.Seconds;
+
+		/* Packages an importer dirtied without saving (animations, edited dependencies) */
+		if (bSave) {
+			const double SaveStartTime = FPlatformTime::Seconds();
+			bSaved &= UEditorLoadingAndSavingUtils::SaveDirtyPackages(false, true);
+			SaveSeconds += FPlatformTime::Seconds() - SaveStartTime;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Packages;
+		Packages.Reserve(SaveReport.Packages.Num());
+
+		for (const FJsonPackageSaveResult& Package : SaveReport.Packages) {
+			const TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+			Result->SetStringField(TEXT("Package"), Package.PackageName);
+			Result->SetBoolField(TEXT("Saved"), Package.bSaved);
+			Result->SetNumberField(TEXT("Seconds"), Package.Seconds);
+
+			Packages.Add(MakeShared<FJsonValueObject>(Result));
+		}
+
+		const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetNumberField(TEXT("Files"), SortedFiles.Num());
+		Report->SetNumberField(TEXT("Imported"), SortedFiles.Num() - NumFailed);
+		Report->SetNumberField(TEXT("Failed"), NumFailed);
+		Report->SetNumberField(TEXT("Threads"), Threads);
+		Report->SetNumberField(TEXT("ImportSeconds"), ImportSeconds);
+		Report->SetBoolField(TEXT("Saved"), bSave && bSaved);
+		Report->SetNumberField(TEXT("SaveSeconds"), SaveSeconds);
+		Report->SetBoolField(TEXT("ConcurrentSave"), SaveReport.bConcurrent);
+		Report->SetArrayField(TEXT("Results"), Results);
+		Report->SetArrayField(TEXT("Packages"), Packages);
+
+		return Report;
+	}
+
+	bool WriteReport(const TSharedRef<FJsonObject>& Report, const FString& ReportPath) {
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Report, Writer);
+
+		if (!FFileHelper::SaveStringToFile(Output, *ReportPath)) {
+			UE_LOG(LogJson, Error, TEXT("Failed to write the report to %s"), *ReportPath);
+			return false;
+		}
+
+		return true;
+	}
+
+	/* Where a worker finds the file list of a job and leaves its report */
+	FString GetJobPath(const FString& WorkerDirectory, const int32 Job, const TCHAR* Extension) {
+		return FPaths::Combine(WorkerDirectory, FString::Printf(TEXT("Job%d%s"), Job, Extension));
+	}
+
+	/*
+	 * A long-lived worker of a coordinator: imports the file list of every job it's handed (one
+	 * per wave it has files in) until it's told to stop or the coordinator is gone.
+	 */
+	int32 RunWorker(const FString& WorkerDirectory, const uint32 CoordinatorId, const int32 Threads, const bool bSave) {
+		/* The coordinator put referenced export files in earlier waves, another worker may be importing one right now */
+		if (IConsoleVariable* ImportMissingReferences = IConsoleManager::Get().FindConsoleVariable(TEXT("JsonAsAsset.ImportMissingReferences"))) {
+			ImportMissingReferences->Set(0, ECVF_SetByCode);
+		}
+
+		IFileManager& FileManager = IFileManager::Get();
+		const FString StopFile = FPaths::Combine(WorkerDirectory, TEXT("Stop"));
+
+		for (int32 Job = 0; ; Job++) {
+			const FString FileList = GetJobPath(WorkerDirectory, Job, TEXT(".txt"));
+
+			while (!FileManager.FileExists(*FileList)) {
+				if (FileManager.FileExists(*StopFile) || (CoordinatorId != 0 && !FPlatformProcess::IsApplicationRunning(CoordinatorId))) return 0;
+
+				FPlatformProcess::Sleep(0.05f);
+			}
+
+			TArray<FString> Files;
+			FFileHelper::LoadFileToStringArray(Files, *FileList);
+
+			/* Files of one wave, they don't reference each other */
+			const TSharedRef<FJsonObject> Report = ImportWaves({ Files }, Threads, bSave);
+
+			/* Moved into place once written, the coordinator never reads half a report */
+			const FString ReportPath = GetJobPath(WorkerDirectory, Job, TEXT(".json"));
+			const FString TempPath = ReportPath + TEXT(".tmp");
+
+			if (WriteReport(Report, TempPath)) {
+				FileManager.Move(*ReportPath, *TempPath);
+			}
+		}
+	}
+
+	/*
+	 * Files joined by a reference end up in the same component. Files of one wave never
+	 * reference each other, so this does nothing for correctness: it only keeps a component on
+	 * the worker that imported the rest of it, which may still have those assets loaded.
+	 */
+	struct FComponents {
+		TArray<int32> Parents;
+
+		explicit FComponents(const int32 Num) {
+			Parents.SetNumUninitialized(Num);
+
+			for (int32 Index = 0; Index < Num; Index++) {
+				Parents[Index] = Index;
+			}
+		}
+
+		int32 Find(int32 Index) {
+			while (Parents[Index] != Index) {
+				Parents[Index] = Parents[Parents[Index]];
+				Index = Parents[Index];
+			}
+
+			return Index;
+		}
+
+		void Union(const int32 A, const int32 B) {
+			Parents[Find(A)] = Find(B);
+		}
+	};
+
+	/*
+	 * Launches Workers editor processes once and hands every wave out to them in shards, waiting
+	 * for all shards before the next wave so references into earlier waves load from saved
+	 * packages. Export files outside the list that it references are imported too, in a wave
+	 * before their first user, so no two workers end up importing the same one on their own.
+	 */
+	int32 RunCoordinator(const TArray<FString>& DirectoryFiles, const int32 Workers, const int32 Threads, const FString& ExportDirectory, const FString& ReportPath) {
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FString> Files = DirectoryFiles;
+		TArray<TArray<FString>> References = FJsonImportPipeline::FindReferences(Files, Threads * Workers);
+
+		TMap<FString, int32> IndexOfFile;
+		IndexOfFile.Reserve(Files.Num());
+
+		for (int32 Index = 0; Index < Files.Num(); Index++) {
+			IndexOfFile.Add(FJsonImportPipeline::NormalizePath(Files[Index]), Index);
+		}
+
+		/* Referenced files can reference more files themselves */
+		for (int32 First = 0; First < Files.Num();) {
+			TArray<FString> Added;
+
+			for (int32 Index = First; Index < Files.Num(); Index++) {
+				for (const FString& Reference : References[Index]) {
+					if (!IndexOfFile.Contains(Reference)) {
+						IndexOfFile.Add(Reference, Files.Num() + Added.Num());
+						Added.Add(Reference);
+					}
+				}
+			}
+
+			First = Files.Num();
+
+			if (Added.Num() == 0) break;
+
+			References.Append(FJsonImportPipeline::FindReferences(Added, Threads * Workers));
+			Files.Append(Added);
+		}
+
+		const int32 NumDependencies = Files.Num() - DirectoryFiles.Num();
+		const TArray<TArray<FString>> Waves = FJsonImportPipeline::SortIntoWaves(Files, References);
+
+		FComponents Components(Files.Num());
+
+		for (int32 Index = 0; Index < Files.Num(); Index++) {
+			for (const FString& Reference : References[Index]) {
+				Components.Union(Index, IndexOfFile.FindChecked(Reference));
+			}
+		}
+
+		if (GetDefault<UJsonAsAssetSettings>()->bEnableLocalFetch) {
+			UE_LOG(LogJson, Warning, TEXT("Workers don't download missing references with Local Fetch, run without -Workers to have them downloaded"));
+		}
+
+		const FString WorkerRoot = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonAsAsset"), TEXT("Workers"));
+		const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+		IFileManager::Get().DeleteDirectory(*WorkerRoot, false, true);
+
+		TArray<FProcHandle> Processes;
+		TArray<FString> WorkerDirectories;
+		TArray<int32> NextJobs;
+
+		for (int32 WorkerIndex = 0; WorkerIndex < Workers; WorkerIndex++) {
+			const FString WorkerDirectory = FPaths::Combine(WorkerRoot, FString::Printf(TEXT("Worker%d"), WorkerIndex));
+			IFileManager::Get().MakeDirectory(*WorkerDirectory, true);
+
+			FString Arguments = FString::Printf(TEXT("\"%s\" -run=JsonAsAssetImport -WorkerDir=\"%s\" -CoordinatorId=%u -Threads=%d -unattended -nopause -nullrhi -nosplash"), *ProjectFile, *WorkerDirectory, FPlatformProcess::GetCurrentProcessId(), Threads);
+
+			if (!ExportDirectory.IsEmpty()) {
+				Arguments += FString::Printf(TEXT(" -ExportDirectory=\"%s\""), *ExportDirectory);
+			}
+
+			FProcHandle Process = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+
+			if (!Process.IsValid()) {
+				UE_LOG(LogJson, Error, TEXT("Failed to launch worker %d"), WorkerIndex);
+				continue;
+			}
+
+			Processes.Add(Process);
+			WorkerDirectories.Add(WorkerDirectory);
+			NextJobs.Add(0);
+		}
+
+		if (Processes.Num() == 0) return 1;
+
+		UE_LOG(LogJson, Display, TEXT("Importing %d files (%d referenced from outside the directory) in %d waves across %d workers"), Files.Num(), NumDependencies, Waves.Num(), Processes.Num());
+
+		TArray<TSharedPtr<FJsonValue>> Results;
+		int32 NumFailed = 0;
+
+		/* Component to the worker that last imported part of it */
+		TMap<int32, int32> WorkerOfComponent;
+
+		for (int32 WaveIndex = 0; WaveIndex < Waves.Num(); WaveIndex++) {
+			TArray<int32> LiveWorkers;
+
+			for (int32 Worker = 0; Worker < Processes.Num(); Worker++) {
+				if (FPlatformProcess::IsProcRunning(Processes[Worker])) LiveWorkers.Add(Worker);
+			}
+
+			if (LiveWorkers.Num() == 0) {
+				for (int32 Remaining = WaveIndex; Remaining < Waves.Num(); Remaining++) {
+					NumFailed += Waves[Remaining].Num();
+				}
+
+				UE_LOG(LogJson, Error, TEXT("Every worker is gone, stopping before wave %d"), WaveIndex + 1);
+				break;
+			}
+
+			TMap<int32, TArray<FString>> Groups;
+
+			for (const FString& File : Waves[WaveIndex]) {
+				const int32 Index = IndexOfFile.FindChecked(FJsonImportPipeline::NormalizePath(File));
+				Groups.FindOrAdd(Components.Find(Index)).Add(File);
+			}
+
+			TArray<TPair<int32, TArray<FString>>> SortedGroups = Groups.Array();
+
+			SortedGroups.Sort([](const TPair<int32, TArray<FString>>& A, const TPair<int32, TArray<FString>>& B) {
+				return A.Value.Num() > B.Value.Num();
+			});
+
+			/* Worker to the files it gets this wave */
+			TMap<int32, TArray<FString>> Shards;
+
+			auto GetLoad = [&Shards](const int32 Worker) {
+				const TArray<FString>* Shard = Shards.Find(Worker);
+				return Shard != nullptr ? Shard->Num() : 0;
+			};
+
+			/* Largest group first onto the least loaded worker, or the one it was on while that keeps the wave even */
+			const int32 Capacity = FMath::DivideAndRoundUp(Waves[WaveIndex].Num(), LiveWorkers.Num());
+
+			for (const TPair<int32, TArray<FString>>& Group : SortedGroups) {
+				int32 Target = LiveWorkers[0];
+
+				for (const int32 Worker : LiveWorkers) {
+					if (GetLoad(Worker) < GetLoad(Target)) Target = Worker;
+				}
+
+				const int32* Previous = WorkerOfComponent.Find(Group.Key);
+
+				if (Previous != nullptr && LiveWorkers.Contains(*Previous) && GetLoad(*Previous) + Group.Value.Num() <= Capacity) {
+					Target = *Previous;
+				}
+
+				WorkerOfComponent.Add(Group.Key, Target);
+				Shards.FindOrAdd(Target).Append(Group.Value);
+			}
+
+			/* Worker and job of every shard handed out */
+			TArray<TPair<int32, int32>> Jobs;
+
+			for (const TPair<int32, TArray<FString>>& Shard : Shards) {
+				const int32 Job = NextJobs[Shard.Key];
+
+				/* Moved into place once written, the worker never reads half a list */
+				const FString FileList = GetJobPath(WorkerDirectories[Shard.Key], Job, TEXT(".txt"));
+				const FString TempPath = FileList + TEXT(".tmp");
+
+				if (!FFileHelper::SaveStringArrayToFile(Shard.Value, *TempPath) || !IFileManager::Get().Move(*FileList, *TempPath)) {
+					UE_LOG(LogJson, Error, TEXT("Failed to hand wave %d to worker %d"), WaveIndex + 1, Shard.Key);
+					continue;
+				}
+
+				NextJobs[Shard.Key]++;
+				Jobs.Emplace(Shard.Key, Job);
+			}
+
+			/* A worker that crashed leaves no report, its files count as failed */
+			int32 NumReported = 0;
+
+			for (const TPair<int32, int32>& Job : Jobs) {
+				const FString JobReport = GetJobPath(WorkerDirectories[Job.Key], Job.Value, TEXT(".json"));
+
+				while (!IFileManager::Get().FileExists(*JobReport) && FPlatformProcess::IsProcRunning(Processes[Job.Key])) {
+					FPlatformProcess::Sleep(0.05f);
+				}
+
+				FString Content;
+				TSharedPtr<FJsonObject> Report;
+
+				const TArray<TSharedPtr<FJsonValue>>* JobResults = nullptr;
+
+				if (FFileHelper::LoadFileToString(Content, *JobReport) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Content), Report) && Report.IsValid() && Report->TryGetArrayField(TEXT("Results"), JobResults)) {
+					for (const TSharedPtr<FJsonValue>& Result : *JobResults) {
+						Results.Add(Result);
+
+						if (!Result->AsObject()->GetBoolField(TEXT("Success"))) NumFailed++;
+					}
+
+					NumReported += JobResults->Num();
+				}
+			}
+
+			NumFailed += Waves[WaveIndex].Num() - NumReported;
+
+			UE_LOG(LogJson, Display, TEXT("Wave %d/%d done, %d files on %d workers"), WaveIndex + 1, Waves.Num(), Waves[WaveIndex].Num(), Jobs.Num());
+		}
+
+		/* Workers waiting for their next job see this and exit */
+		for (const FString& WorkerDirectory : WorkerDirectories) {
+			FFileHelper::SaveStringToFile(FString(), *FPaths::Combine(WorkerDirectory, TEXT("Stop")));
+		}
+
+		for (FProcHandle& Process : Processes) {
+			FPlatformProcess::WaitForProc(Process);
+			FPlatformProcess::CloseProc(Process);
+		}
+
+		const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetNumberField(TEXT("Files"), Files.Num());
+		Report->SetNumberField(TEXT("Dependencies"), NumDependencies);
+		Report->SetNumberField(TEXT("Imported"), Files.Num() - NumFailed);
+		Report->SetNumberField(TEXT("Failed"), NumFailed);
+		Report->SetNumberField(TEXT("Waves"), Waves.Num());
+		Report->SetNumberField(TEXT("Workers"), Processes.Num());
+		Report->SetNumberField(TEXT("Threads"), Threads);
+		Report->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+		Report->SetArrayField(TEXT("Results"), Results);
+
+		WriteReport(Report, ReportPath);
+
+		UE_LOG(LogJson, Display, TEXT("Imported %d of %d files with %d workers in %.1f s. Report: %s"), Files.Num() - NumFailed, Files.Num(), Processes.Num(), FPlatformTime::Seconds() - StartTime, *ReportPath);
+
+		return NumFailed == 0 ? 0 : 1;
+	}
+}
+
+UJsonAsAssetImportCommandlet::UJsonAsAssetImportCommandlet() {
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UJsonAsAssetImportCommandlet::Main(const FString& Params) {
+	FString Directory;
+	FString FileList;
+
+	FString WorkerDirectory;
+
+	const bool bDirectory = FParse::Value(*Params, TEXT("Dir="), Directory);
+	const bool bFileList = FParse::Value(*Params, TEXT("FileList="), FileList);
+	const bool bWorker = FParse::Value(*Params, TEXT("WorkerDir="), WorkerDirectory);
+
+	if (!bDirectory && !bFileList && !bWorker) {
+		UE_LOG(LogJson, Error, TEXT("Usage: -run=JsonAsAssetImport -Dir=<Directory> [-ExportDirectory=<Directory>] [-Threads=N] [-Workers=N] [-Report=<File>] [-NoSave]"));
+		return 1;
+	}
+
+	int32 Workers = 1;
+	FParse::Value(*Params, TEXT("Workers="), Workers);
+	Workers = FMath::Max(1, Workers);
+
+	/* Workers share the machine's cores */
+	int32 Threads = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads() / Workers);
+	FParse::Value(*Params, TEXT("Threads="), Threads);
+	Threads = FMath::Max(1, Threads);
+
+	FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonAsAsset"), TEXT("ImportReport.json"));
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+	FString ExportDirectory;
+	if (FParse::Value(*Params, TEXT("ExportDirectory="), ExportDirectory)) {
+		GetMutableDefault<UJsonAsAssetSettings>()->ExportDirectory.Path = ExportDirectory.Replace(TEXT("\\"), TEXT("/"));
+	}
+
+	/* References resolve through the manifest, a headless run can afford to wait for it */
+	FJsonExportManifest& Manifest = FJsonExportManifest::Get();
+	Manifest.Rebuild();
+	Manifest.WaitUntilReady();
+
+	/* A worker of a coordinator, it's handed one file list per wave */
+	if (bWorker) {
+		uint32 CoordinatorId = 0;
+		FParse::Value(*Params, TEXT("CoordinatorId="), CoordinatorId);
+
+		return RunWorker(WorkerDirectory, CoordinatorId, Threads, bSave);
+	}
+
+	/* A list of files in the order to import them */
+	if (bFileList) {
+		TArray<FString> Files;
+		FFileHelper::LoadFileToStringArray(Files, *FileList);
+
+		/* Files of one wave, they don't reference each other */
+		const TSharedRef<FJsonObject> Report = ImportWaves({ Files }, Threads, bSave);
+		WriteReport(Report, ReportPath);
+
+		return Report->GetIntegerField(TEXT("Failed")) == 0 && (!bSave || Report->GetBoolField(TEXT("Saved"))) ? 0 : 1;
+	}
+
+	Directory = FPaths::ConvertRelativePathToFull(Directory);
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *Directory, TEXT("*.json"), true, false);
+
+	if (Files.Num() == 0) {
+		UE_LOG(LogJson, Error, TEXT("No JSON files found in %s"), *Directory);
+		return 1;
+	}
+
+	Files.Sort();
+
+	if (Workers > 1) {
+		if (!bSave) {
+			UE_LOG(LogJson, Warning, TEXT("-NoSave is ignored with -Workers, later waves load what earlier ones saved"));
+		}
+
+		return RunCoordinator(Files, Workers, Threads, ExportDirectory, ReportPath);
+	}
+
+	const TArray<TArray<FString>> Waves = FJsonImportPipeline::SortIntoWaves(Files, Threads);
+
+	UE_LOG(LogJson, Display, TEXT("Importing %d files from %s in %d waves"), Files.Num(), *Directory, Waves.Num());
+
+	const TSharedRef<FJsonObject> Report = ImportWaves(Waves, Threads, bSave);
+	Report->SetStringField(TEXT("Directory"), Directory);
+	Report->SetNumberField(TEXT("Waves"), Waves.Num());
+
+	WriteReport(Report, ReportPath);
+
+	const int32 NumFailed = Report->GetIntegerField(TEXT("Failed"));
+	UE_LOG(LogJson, Display, TEXT("Imported %d of %d files. Report: %s"), Files.Num() - NumFailed, Files.Num(), *ReportPath);
+
+	return NumFailed == 0 && (!bSave || Report->GetBoolField(TEXT("Saved"))) ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 
 #include "Importers/Constructor/Graph/MaterialGraph.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/JsonTypeCache.h"
 #include "Styling/SlateIconFinder.h"
 
 // Expressions
@@ -35,25 +36,32 @@ IMaterialGraph::IMaterialGraph(const FString& FileName, const FString& FilePath,
 TSharedPtr<FJsonObject> IMaterialGraph::FindEditorOnlyData(const FString& Type, const FString& Outer, TMap<FName, FExportData>& OutExports, TArray<FName>& ExpressionNames, bool bFilterByOuter) {
 	TSharedPtr<FJsonObject> EditorOnlyData;
 
-	for (const TSharedPtr<FJsonValue> Value : bFilterByOuter ? FilterExportsByOuter(Outer) : AllJsonObjects) {
-		TSharedPtr<FJsonObject> Object = TSharedPtr<FJsonObject>(Value->AsObject());
+	const FName EditorOnlyType(*(Type + "EditorOnlyData"));
+	const FName MainType(*Type);
+	const FName OuterName(*Outer);
 
-		FString ExType = Object->GetStringField(TEXT("Type"));
-		FString Name = Object->GetStringField(TEXT("Name"));
+	const FExportIndex& Exports = GetExportIndex();
 
-		if (ExType == Type + "EditorOnlyData") {
-			EditorOnlyData = Object;
-			continue;
-		}
+	TArray<int32> AllIndices;
+	if (!bFilterByOuter) {
+		AllIndices.Reserve(Exports.Num());
+		for (int32 Index = 0; Index < Exports.Num(); Index++) AllIndices.Add(Index);
+	}
+
+	for (const int32 Index : bFilterByOuter ? Exports.FindByOuter(OuterName) : AllIndices) {
+		const FExportData& Export = Exports.GetData(Index);
+		TSharedPtr<FJsonObject> Object = Exports.GetObject(Index);
 
 		// For older versions, the "editor" data is in the main UMaterial/UMaterialFunction export
-		if (ExType == Type) {
+		if (Export.Type == EditorOnlyType || Export.Type == MainType) {
 			EditorOnlyData = Object;
 			continue;
 		}
 
-		ExpressionNames.Add(FName(Name));
-		OutExports.Add(FName(Name), FExportData(ExType, Outer, Object));
+		const FName Name(*Object->GetStringField(TEXT("Name")));
+
+		ExpressionNames.Add(Name);
+		OutExports.Add(Name, FExportData(Export.Type, OuterName, Object));
 	}
 
 	return EditorOnlyData;
@@ -67,15 +75,12 @@ TMap<FName, UMaterialExpression*> IMaterialGraph::ConstructExpressions(UObject*
 		FJsonObject* SharedRef = nullptr;
 		bool bFound = false;
 
-		for (TTuple<FName, FExportData>& Key : Exports) {
-			TSharedPtr<FJsonObject>* SharedO = new TSharedPtr<FJsonObject>(Key.Value.Json);
-
-			if (Key.Key == Name && Key.Value.Outer == FName(*Outer)) {
-				Type = Key.Value.Type;
-				SharedRef = SharedO->Get();
+		if (const FExportData* Export = Exports.Find(Name)) {
+			if (Export->Outer == FName(*Outer)) {
+				Type = Export->Type;
+				SharedRef = Export->Json;
 
 				bFound = true;
-				break;
 			}
 		}
 
@@ -327,7 +332,8 @@ UMaterialExpression* IMaterialGraph::CreateEmptyExpression(UObject* Parent, FNam
 	if (IgnoredExpressions.Contains(Type.ToString())) // Unhandled expressions
 		return nullptr;
 
-	const UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString());
+	FJsonTypeCache& TypeCache = FJsonTypeCache::Get();
+	UClass* Class = TypeCache.Find<UClass>(Type.ToString());
 
 	if (!Class) {
 #if ENGINE_MAJOR_VERSION >= 5
@@ -343,7 +349,10 @@ UMaterialExpression* IMaterialGraph::CreateEmptyExpression(UObject* Parent, FNam
 #endif
 
 		if (!Class) 
-			Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString().Replace(TEXT("MaterialExpressionPhysicalMaterialOutput"), TEXT("MaterialExpressionLandscapePhysicalMaterialOutput")));
+			Class = TypeCache.Find<UClass>(Type.ToString().Replace(TEXT("MaterialExpressionPhysicalMaterialOutput"), TEXT("MaterialExpressionLandscapePhysicalMaterialOutput")));
+
+		// Redirects are only probed for the first expression of this type
+		TypeCache.Remember(Type.ToString(), Class);
 	}
 
 	// Show missing nodes in graph
@@ -380,7 +389,7 @@ UMaterialExpression* IMaterialGraph::CreateEmptyExpression(UObject* Parent, FNam
 	return NewObject<UMaterialExpression>
 	(
 		Parent,
-		Class, // Find class using ANY_PACKAGE (may error in the future)
+		Class,
 		Name,
 		RF_Transactional
 	);
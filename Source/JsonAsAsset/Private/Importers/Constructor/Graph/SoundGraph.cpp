@@ -9,6 +9,7 @@
 #include "Misc/MessageDialog.h"
 #include "Sound/SoundCue.h"
 #include "Settings/JsonAsAssetSettings.h"
+#include "Utilities/JsonTypeCache.h"
 
 void ISoundGraph::ConstructNodes(USoundCue* SoundCue, TArray<TSharedPtr<FJsonValue>> JsonArray, TMap<FString, USoundNode*>& OutNodes) {
 	for (TSharedPtr<FJsonValue> JsonValue : JsonArray) {
@@ -31,7 +32,7 @@ void ISoundGraph::ConstructNodes(USoundCue* SoundCue, TArray<TSharedPtr<FJsonVal
 }
 
 USoundNode* ISoundGraph::CreateEmptyNode(FName Name, FName Type, USoundCue* SoundCue) {
-	UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString());
+	UClass* Class = FJsonTypeCache::Get().Find<UClass>(Type.ToString());
 
 	// TODO: Construct the sound node manually to have the exact same object name
 	return SoundCue->ConstructSoundNode<USoundNode>(
@@ -166,7 +167,7 @@ void ISoundGraph::ImportSoundWave(const FString& URL, FString SavePath, FString
 {
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	
-	HttpRequest->OnProcessRequestComplete().BindLambda([this, SavePath, AssetPtr, Node](const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bWasSuccessful)
+	HttpRequest->OnProcessRequestComplete().BindLambda([SavePath, AssetPtr, Node](const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bWasSuccessful)
 	{
 		OnDownloadSoundWave(Request, Response, bWasSuccessful, SavePath, AssetPtr, Node);
 	});
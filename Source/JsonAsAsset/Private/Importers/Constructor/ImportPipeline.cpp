@@ -0,0 +1,376 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Importers/Constructor/ImportPipeline.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Utilities/JsonArena.h"
+#include "Utilities/JsonExportManifest.h"
+#include "Utilities/JsonStreamReader.h"
+#include "Utilities/JsonUtilities.h"
+
+namespace {
+	/* Collects every ObjectPath under Value, which is how exports point at other packages */
+	void CollectObjectPaths(const TSharedPtr<FJsonValue>& Value, TSet<FString>& OutPaths) {
+		if (!Value.IsValid()) return;
+
+		if (Value->Type == EJson::Array) {
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray()) {
+				CollectObjectPaths(Element, OutPaths);
+			}
+		} else if (Value->Type == EJson::Object) {
+			const TSharedPtr<FJsonObject> Object = Value->AsObject();
+
+			FString ObjectPath;
+			if (Object->TryGetStringField(TEXT("ObjectPath"), ObjectPath)) {
+				OutPaths.Add(ObjectPath);
+			}
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values) {
+				CollectObjectPaths(Pair.Value, OutPaths);
+			}
+		}
+	}
+
+	/* Same over an arena document, where nothing has to be converted */
+	void CollectObjectPaths(const FJsonArenaNode& Node, TSet<FString>& OutPaths) {
+		static const FName ObjectPathKey(TEXT("ObjectPath"));
+
+		if (Node.IsArray()) {
+			for (const FJsonArenaNode& Element : Node.GetElements()) {
+				CollectObjectPaths(Element, OutPaths);
+			}
+		} else if (Node.IsObject()) {
+			FString ObjectPath;
+			if (Node.TryGetString(ObjectPathKey, ObjectPath)) {
+				OutPaths.Add(ObjectPath);
+			}
+
+			for (const FJsonArenaField& Field : Node.GetFields()) {
+				CollectObjectPaths(Field.Value, OutPaths);
+			}
+		}
+	}
+
+	/* Export files the object paths point at, found through the export manifest */
+	void ResolveReferences(const FString& File, const FString& ExportDirectory, const TSet<FString>& ObjectPaths, TArray<FString>& OutReferences) {
+		if (ExportDirectory.IsEmpty()) return;
+
+		/* Same code name lookup as IImporter::ImportAssetReference */
+		FString CodeName;
+		File.Split(ExportDirectory + "/", nullptr, &CodeName);
+		CodeName.Split("/", &CodeName, nullptr, ESearchCase::IgnoreCase, ESearchDir::FromStart);
+
+		const FJsonExportManifest& Manifest = FJsonExportManifest::Get();
+
+		for (const FString& ObjectPath : ObjectPaths) {
+			FString RelativePath = ObjectPath;
+			RelativePath.Split(".", &RelativePath, nullptr, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+
+			if (RelativePath.StartsWith(TEXT("/Game/"))) {
+				RelativePath = CodeName / TEXT("Content") / RelativePath.Mid(6);
+			} else if (RelativePath.StartsWith(TEXT("/"))) {
+				/* Engine, plugin and script packages aren't in the export directory */
+				continue;
+			}
+
+			FJsonExportManifestEntry Entry;
+
+			if (Manifest.FindEntry(RelativePath, Entry) && Entry.FilePath != File) {
+				OutReferences.AddUnique(Entry.FilePath);
+			}
+		}
+	}
+
+	/* References of a file without building its FJsonValue tree, for when nothing else is needed */
+	TArray<FString> ScanReferences(const FString& File, const FString& ExportDirectory) {
+		TArray<FString> References;
+
+		FJsonArenaDocument Document;
+		if (!Document.ParseFile(File)) return References;
+
+		TSet<FString> ObjectPaths;
+		CollectObjectPaths(Document.GetRoot(), ObjectPaths);
+
+		/* The strings were copied out, the arena can go before the manifest is asked */
+		Document.Reset();
+
+		ResolveReferences(File, ExportDirectory, ObjectPaths, References);
+
+		return References;
+	}
+}
+
+FJsonImportPipeline& FJsonImportPipeline::Get() {
+	static FJsonImportPipeline Pipeline;
+	return Pipeline;
+}
+
+void FJsonImportPipeline::Prepare(const TArray<FString>& Files, const bool bPrefetchReferences) {
+	/* Settings are read here, workers don't touch UObjects */
+	const FString ExportDirectory = FJsonExportManifest::GetExportDirectory();
+
+	for (const FString& File : Files) {
+		Launch(File, ExportDirectory, bPrefetchReferences);
+	}
+}
+
+void FJsonImportPipeline::Launch(const FString& File, const FString& ExportDirectory, const bool bPrefetchReferences) {
+	const FString Key = NormalizePath(File);
+
+	FScopeLock Lock(&Mutex);
+	if (Pending.Contains(Key)) return;
+
+	Pending.Add(Key, Async(EAsyncExecution::ThreadPool, [this, Key, ExportDirectory, bPrefetchReferences]() {
+		TSharedPtr<const FJsonImportPlan> Plan = BuildPlan(Key, ExportDirectory);
+
+		/* One level deep, references of references are parsed when they're imported */
+		if (bPrefetchReferences) {
+			for (const FString& Reference : Plan->References) {
+				Launch(Reference, ExportDirectory, false);
+			}
+		}
+
+		return Plan;
+	}).Share());
+}
+
+TSharedRef<const FJsonImportPlan> FJsonImportPipeline::TakePlan(const FString& File) {
+	const FString Key = NormalizePath(File);
+
+	TSharedFuture<TSharedPtr<const FJsonImportPlan>> Future;
+
+	{
+		FScopeLock Lock(&Mutex);
+		Pending.RemoveAndCopyValue(Key, Future);
+	}
+
+	if (Future.IsValid()) {
+		return Future.Get().ToSharedRef();
+	}
+
+	return BuildPlan(Key, FJsonExportManifest::GetExportDirectory()).ToSharedRef();
+}
+
+TSharedRef<const FJsonImportPlan> FJsonImportPipeline::PeekPlan(const FString& File) {
+	const FString Key = NormalizePath(File);
+
+	TSharedFuture<TSharedPtr<const FJsonImportPlan>> Future;
+	TPromise<TSharedPtr<const FJsonImportPlan>> Promise;
+
+	{
+		FScopeLock Lock(&Mutex);
+
+		if (const TSharedFuture<TSharedPtr<const FJsonImportPlan>>* Found = Pending.Find(Key)) {
+			Future = *Found;
+		} else {
+			/* Claimed before building, so a file launched meanwhile waits for this plan instead of replacing it */
+			Pending.Add(Key, Promise.GetFuture().Share());
+		}
+	}
+
+	/* Waited on outside the lock, the task may be launching the files it references */
+	if (Future.IsValid()) {
+		return Future.Get().ToSharedRef();
+	}
+
+	/* Kept for whoever takes it next */
+	const TSharedPtr<const FJsonImportPlan> Plan = BuildPlan(Key, FJsonExportManifest::GetExportDirectory());
+	Promise.SetValue(Plan);
+
+	return Plan.ToSharedRef();
+}
+
+TArray<FString> FJsonImportPipeline::SortByDependencies(const TArray<FString>& Files) {
+	TArray<TArray<FString>> References;
+	References.Reserve(Files.Num());
+
+	for (const FString& File : Files) {
+		References.Add(PeekPlan(File)->References);
+	}
+
+	TArray<FString> Sorted;
+	Sorted.Reserve(Files.Num());
+
+	for (const TArray<int32>& Wave : SortIndicesIntoWaves(Files, References)) {
+		for (const int32 Index : Wave) {
+			Sorted.Add(Files[Index]);
+		}
+	}
+
+	return Sorted;
+}
+
+TArray<TArray<FString>> FJsonImportPipeline::SortIntoWaves(const TArray<FString>& Files, const int32 MaxConcurrency, TArray<TArray<FString>>* OutReferences) {
+	TArray<TArray<FString>> References = FindReferences(Files, MaxConcurrency);
+	TArray<TArray<FString>> Waves = SortIntoWaves(Files, References);
+
+	if (OutReferences != nullptr) {
+		*OutReferences = MoveTemp(References);
+	}
+
+	return Waves;
+}
+
+TArray<TArray<FString>> FJsonImportPipeline::SortIntoWaves(const TArray<FString>& Files, const TArray<TArray<FString>>& References) {
+	TArray<TArray<FString>> Waves;
+
+	for (const TArray<int32>& Wave : SortIndicesIntoWaves(Files, References)) {
+		TArray<FString>& Sorted = Waves.AddDefaulted_GetRef();
+		Sorted.Reserve(Wave.Num());
+
+		for (const int32 Index : Wave) {
+			Sorted.Add(Files[Index]);
+		}
+	}
+
+	return Waves;
+}
+
+TArray<TArray<FString>> FJsonImportPipeline::FindReferences(const TArray<FString>& Files, const int32 MaxConcurrency, const TFunction<bool(int32 NumScanned)>& OnProgress) {
+	const FString ExportDirectory = FJsonExportManifest::GetExportDirectory();
+
+	/* Files are parsed into arenas for their references and freed right after, no FJsonValue tree is built */
+	TArray<TArray<FString>> References;
+	References.SetNum(Files.Num());
+
+	const int32 BatchSize = MaxConcurrency > 0 ? MaxConcurrency : FMath::Max(Files.Num(), 1);
+
+	for (int32 First = 0; First < Files.Num(); First += BatchSize) {
+		ParallelFor(FMath::Min(BatchSize, Files.Num() - First), [&Files, &ExportDirectory, &References, First](const int32 Offset) {
+			const FString File = NormalizePath(Files[First + Offset]);
+			References[First + Offset] = ScanReferences(File, ExportDirectory);
+		});
+
+		if (OnProgress && !OnProgress(FMath::Min(First + BatchSize, Files.Num()))) break;
+	}
+
+	return References;
+}
+
+TArray<TArray<int32>> FJsonImportPipeline::SortIndicesIntoWaves(const TArray<FString>& Files, const TArray<TArray<FString>>& References) {
+	TMap<FString, int32> IndexOfFile;
+	IndexOfFile.Reserve(Files.Num());
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		IndexOfFile.Add(NormalizePath(Files[Index]), Index);
+	}
+
+	/* Edges go from a file to the files in the list that reference it */
+	TArray<TArray<int32>> Dependents;
+	TArray<int32> NumDependencies;
+
+	Dependents.SetNum(Files.Num());
+	NumDependencies.SetNumZeroed(Files.Num());
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		for (const FString& Reference : References[Index]) {
+			const int32* Dependency = IndexOfFile.Find(Reference);
+
+			if (Dependency != nullptr && *Dependency != Index) {
+				Dependents[*Dependency].Add(Index);
+				NumDependencies[Index]++;
+			}
+		}
+	}
+
+	TArray<TArray<int32>> Waves;
+	TArray<int32> Ready;
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		if (NumDependencies[Index] == 0) Ready.Add(Index);
+	}
+
+	int32 NumSorted = 0;
+
+	while (Ready.Num() > 0) {
+		TArray<int32> Next;
+
+		for (const int32 Index : Ready) {
+			for (const int32 Dependent : Dependents[Index]) {
+				if (--NumDependencies[Dependent] == 0) Next.Add(Dependent);
+			}
+		}
+
+		/* Keeps the list's order within a wave */
+		Next.Sort();
+
+		NumSorted += Ready.Num();
+		Waves.Add(MoveTemp(Ready));
+
+		Ready = MoveTemp(Next);
+	}
+
+	/* Whatever is left depends on itself somewhere, it goes last in the list's order */
+	if (NumSorted < Files.Num()) {
+		TArray<int32>& Remaining = Waves.AddDefaulted_GetRef();
+
+		for (int32 Index = 0; Index < Files.Num(); Index++) {
+			if (NumDependencies[Index] > 0) Remaining.Add(Index);
+		}
+	}
+
+	return Waves;
+}
+
+void FJsonImportPipeline::Reset() {
+	/* Finished plans can launch references, so go again until nothing is left */
+	while (true) {
+		TMap<FString, TSharedFuture<TSharedPtr<const FJsonImportPlan>>> Unclaimed;
+
+		{
+			FScopeLock Lock(&Mutex);
+			Unclaimed = MoveTemp(Pending);
+			Pending.Reset();
+		}
+
+		if (Unclaimed.Num() == 0) return;
+
+		for (TPair<FString, TSharedFuture<TSharedPtr<const FJsonImportPlan>>>& Pair : Unclaimed) {
+			Pair.Value.Wait();
+		}
+	}
+}
+
+TSharedPtr<const FJsonImportPlan> FJsonImportPipeline::BuildPlan(const FString& File, const FString& ExportDirectory) {
+	const TSharedPtr<FJsonImportPlan> Plan = MakeShared<FJsonImportPlan>();
+	Plan->File = File;
+
+	Plan->bParsed = FJsonStreamReader::LoadArrayFile(File, Plan->Exports, &Plan->Error);
+	if (!Plan->bParsed) return Plan;
+
+	Plan->Types.Reserve(Plan->Exports.Num());
+	Plan->Names.Reserve(Plan->Exports.Num());
+
+	TSet<FString> ObjectPaths;
+
+	for (const TSharedPtr<FJsonValue>& Export : Plan->Exports) {
+		const TSharedPtr<FJsonObject> Object = Export.IsValid() && Export->Type == EJson::Object ? Export->AsObject() : nullptr;
+
+		FString& Type = Plan->Types.AddDefaulted_GetRef();
+		FString& Name = Plan->Names.AddDefaulted_GetRef();
+
+		if (Object.IsValid()) {
+			Object->TryGetStringField(TEXT("Type"), Type);
+			Object->TryGetStringField(TEXT("Name"), Name);
+		}
+
+		CollectObjectPaths(Export, ObjectPaths);
+	}
+
+	ResolveReferences(File, ExportDirectory, ObjectPaths, Plan->References);
+
+	Plan->ExportIndex = MakeShared<const FExportIndex>(Plan->Exports);
+
+	return Plan;
+}
+
+FString FJsonImportPipeline::NormalizePath(const FString& File) {
+	FString FullPath = FPaths::ConvertRelativePathToFull(File);
+	FPaths::NormalizeFilename(FullPath);
+
+	return FullPath;
+}
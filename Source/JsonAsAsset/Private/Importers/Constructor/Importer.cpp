@@ -1,6 +1,8 @@
-// Copyright JAA Contributors 2024-2025
+﻿// Copyright JAA Contributors 2024-2025
 
 #include "Importers/Constructor/Importer.h"
+#include "Importers/Constructor/ImportPipeline.h"
+#include "Importers/Constructor/SerializerPool.h"
 
 #include "Settings/JsonAsAssetSettings.h"
 
@@ -11,12 +13,16 @@
 
 // Utilities
 #include "Utilities/AssetUtilities.h"
-
+#include "Utilities/JsonAssetCreationQueue.h"
+#include "Utilities/JsonExportManifest.h"
+#include "Utilities/JsonImportProgress.h"
+#include "Utilities/JsonReferenceCache.h"
+#include "Utilities/JsonTypeCache.h"
+#include "Utilities/JsonImportReferences.h"
+#include "Utilities/JsonPackageSaveQueue.h"
+
+#include "HAL/IConsoleManager.h"
 #include "Misc/MessageDialog.h"
-#include "UObject/SavePackage.h"
-
-// Slate Icons
-#include "Styling/SlateIconFinder.h"
 
 // ----> Importers
 // Particle System Importing is not finalized
@@ -64,6 +70,13 @@
 
 #define LOCTEXT_NAMESPACE "IImporter"
 
+static TAutoConsoleVariable<int32> CVarImportMissingReferences(
+	TEXT("JsonAsAsset.ImportMissingReferences"),
+	1,
+	TEXT("0 to leave references that can't be loaded unresolved instead of importing them from the export directory or downloading them with Local Fetch. Workers of the import commandlet run with 0: their coordinator imports the export files they reference in an earlier wave, so no two workers import the same one."),
+	ECVF_Default
+);
+
 // Importer Construction
 IImporter::IImporter(const FString& FileName, const FString& FilePath, 
 		  const TSharedPtr<FJsonObject>& JsonObject, UPackage* Package, 
@@ -71,9 +84,32 @@ IImporter::IImporter(const FString& FileName, const FString& FilePath,
 	: AllJsonObjects(AllJsonObjects), JsonObject(JsonObject), FileName(FileName),
 	  FilePath(FilePath), Package(Package), OutermostPkg(OutermostPkg), ParentObject(nullptr)
 {
-	PropertySerializer = NewObject<UPropertySerializer>();
-	GObjectSerializer = NewObject<UObjectSerializer>();
-	GObjectSerializer->SetPropertySerializer(PropertySerializer);
+	GObjectSerializer = FJsonSerializerPool::Get().Acquire();
+	PropertySerializer = GObjectSerializer->GetPropertySerializer();
+}
+
+const FExportIndex& IImporter::GetExportIndex() const {
+	if (!ExportIndex.IsValid()) {
+		ExportIndex = MakeShared<const FExportIndex>(AllJsonObjects);
+	}
+
+	return *ExportIndex;
+}
+
+void IImporter::SetExportIndex(const TSharedRef<const FExportIndex>& Index) {
+	ExportIndex = Index;
+
+	// Object properties pointing at subobjects of the file are filled in from their exports
+	if (GObjectSerializer != nullptr) {
+		GObjectSerializer->SetupExports(Index);
+	}
+}
+
+IImporter::~IImporter() {
+	// Hands the serializers back reset, the next importer picks them up
+	if (GObjectSerializer != nullptr) {
+		FJsonSerializerPool::Get().Release(GObjectSerializer);
+	}
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -149,10 +185,14 @@ TArray<FString> ImporterAcceptedTypes = {
 
 // Handles the JSON of a file.
 // I want to replace Handle with Import in most of these functions
-bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString File, const bool bHideNotifications) const
+bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString File, const bool bHideNotifications, TSharedPtr<const FExportIndex> Index) const
 {
-	TArray<FString> Types;
-	for (const TSharedPtr<FJsonValue>& Obj : Exports) Types.Add(Obj->AsObject()->GetStringField(TEXT("Type")));
+	bool bAllImported = true;
+
+	// One index for the file, every importer below shares it
+	if (!Index.IsValid()) {
+		Index = MakeShared<const FExportIndex>(Exports);
+	}
 
 	for (const TSharedPtr<FJsonValue>& ExportPtr : Exports) {
 		TSharedPtr<FJsonObject> DataObject = ExportPtr->AsObject();
@@ -160,7 +200,7 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 		FString Type = DataObject->GetStringField(TEXT("Type"));
 		FString Name = DataObject->GetStringField(TEXT("Name"));
 
-		UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type);
+		UClass* Class = FJsonTypeCache::Get().Find<UClass>(Type);
 
 		if (Class == nullptr) continue;
 		bool bDataAsset = Class->IsChildOf(UDataAsset::StaticClass());
@@ -170,67 +210,67 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 			// NOTE: Used for references
 			if (FPaths::IsRelative(File)) File = FPaths::ConvertRelativePathToFull(File);
 
-			IImporter* Importer;
+			TUniquePtr<IImporter> Importer;
 			if (Type == "AnimSequence" || Type == "AnimMontage") 
-				Importer = new IAnimationBaseImporter(Name, File, DataObject, nullptr, nullptr);
+				Importer = MakeUnique<IAnimationBaseImporter>(Name, File, DataObject, nullptr, nullptr);
 			else {
 				UPackage* LocalOutermostPkg;
 				UPackage* LocalPackage = FAssetUtilities::CreateAssetPackage(Name, File, LocalOutermostPkg);
 
 				// Curve Importers
 				if (Type == "CurveFloat") 
-					Importer = new ICurveFloatImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<ICurveFloatImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 				else if (Type == "CurveTable") 
-					Importer = new ICurveTableImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<ICurveTableImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 				else if (Type == "CurveVector") 
-					Importer = new ICurveVectorImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<ICurveVectorImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 				else if (Type == "CurveLinearColor") 
-					Importer = new ICurveLinearColorImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<ICurveLinearColorImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 				else if (Type == "CurveLinearColorAtlas") 
-					Importer = new ICurveLinearColorAtlasImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<ICurveLinearColorAtlasImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 
 				else if (Type == "Skeleton") 
-					Importer = new ISkeletonImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<ISkeletonImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 
 				else if (Type == "BlendSpace") 
-					Importer = new IBlendSpaceImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+					Importer = MakeUnique<IBlendSpaceImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 
 				else if (Type == "SoundCue") 
-					Importer = new ISoundCueImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<ISoundCueImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 
 #if JSONASASSET_PARTICLESYSTEM_ALLOW
 				else if (Type == "ParticleSystem") 
-					Importer = new IParticleSystemImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<IParticleSystemImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 #endif
 				
 				else if (Type == "Material") 
-					Importer = new IMaterialImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<IMaterialImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 				else if (Type == "MaterialFunction") 
-					Importer = new IMaterialFunctionImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<IMaterialFunctionImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 				else if (Type == "MaterialInstanceConstant") 
-					Importer = new IMaterialInstanceConstantImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<IMaterialInstanceConstantImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 
 				else if (Type == "PhysicsAsset") 
-					Importer = new IPhysicsAssetImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+					Importer = MakeUnique<IPhysicsAssetImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 				
 				// Other Importers
 				else if (Type == "NiagaraParameterCollection") 
-				    Importer = new INiagaraParameterCollectionImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+				    Importer = MakeUnique<INiagaraParameterCollectionImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
  				else if (Type == "DataTable") 
-				    Importer = new IDataTableImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+				    Importer = MakeUnique<IDataTableImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 
  				else if (Type == "UserDefinedEnum") 
- 					Importer = new IUserDefinedEnumImporter(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
+ 					Importer = MakeUnique<IUserDefinedEnumImporter>(Name, File, DataObject, LocalPackage, LocalOutermostPkg);
 
 				else // Data Asset
 					if (bDataAsset)
-						Importer = new IDataAssetImporter(Class, Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
+						Importer = MakeUnique<IDataAssetImporter>(Class, Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 
 				else { // Templates handled here
-					UClass* LoadedClass = FindObject<UClass>(ANY_PACKAGE, *Type);
+					UClass* LoadedClass = FJsonTypeCache::Get().Find<UClass>(Type);
 
 					if (LoadedClass != nullptr) {
-						Importer = new ITemplatedImporter<UObject>(LoadedClass, Name, File, DataObject, LocalPackage, LocalOutermostPkg, AllJsonObjects);
+						Importer = MakeUnique<ITemplatedImporter<UObject>>(LoadedClass, Name, File, DataObject, LocalPackage, LocalOutermostPkg, AllJsonObjects);
 					} else { // No template found
 						UE_LOG(LogTemp, Error, TEXT("Failed to load class for type: %s"), *Type);
 						
@@ -239,7 +279,9 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 				}
 			}
 
-			FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
+			if (Importer.IsValid()) {
+				Importer->SetExportIndex(Index.ToSharedRef());
+			}
 
 			if (bHideNotifications) {
 				try {
@@ -253,55 +295,32 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 				return true;
 			}
 
-			if (Importer != nullptr && Importer->Import()) {
+			if (Importer.IsValid() && Importer->Import()) {
 				UE_LOG(LogJson, Log, TEXT("Successfully imported \"%s\" as \"%s\""), *Name, *Type);
 				
 				if (!(Type == "AnimSequence" || Type == "AnimMontage"))
 					Importer->SavePackage();
 
-				// Notification for asset
-				AppendNotification(
-					FText::FromString("Imported type: " + Type),
-					FText::FromString(Name),
-					2.0f,
-					FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail")),
-					SNotificationItem::CS_Success,
-					false,
-					350.0f
-				);
-
-				MessageLogger.Message(EMessageSeverity::Info, FText::FromString("Imported Asset: " + Name + " (" + Type + ")"));
-			} else AppendNotification(
-				FText::FromString("Import Failed: " + Type),
-				FText::FromString(Name),
-				2.0f,
-				FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail")),
-				SNotificationItem::CS_Fail,
-				false,
-				350.0f
-			);
+				// Notification for asset, folded into the session's progress during batches
+				FJsonImportProgress::Get().Record(EJsonImportEvent::Imported, Type, Name);
+			} else {
+				bAllImported = false;
+
+				FJsonImportProgress::Get().Record(EJsonImportEvent::ImportFailed, Type, Name);
+			}
 		}
 	}
 
-	return true;
+	return bAllImported;
 }
 
 TArray<TSharedPtr<FJsonValue>> IImporter::GetObjectsWithTypeStartingWith(const FString& StartsWithStr) {
 	TArray<TSharedPtr<FJsonValue>> FilteredObjects;
 
-	for (const TSharedPtr<FJsonValue>& JsonObjectValue : AllJsonObjects) {
-		if (JsonObjectValue->Type == EJson::Object) {
-			TSharedPtr<FJsonObject> JsonObjectType = JsonObjectValue->AsObject();
-
-			if (JsonObjectType.IsValid() && JsonObjectType->HasField(TEXT("Type"))) {
-				FString TypeValue = JsonObjectType->GetStringField(TEXT("Type"));
+	const FExportIndex& Exports = GetExportIndex();
 
-				// Check if the "Type" field starts with the specified string
-				if (TypeValue.StartsWith(StartsWithStr)) {
-					FilteredObjects.Add(JsonObjectValue);
-				}
-			}
-		}
+	for (const int32 Index : Exports.FindByTypePrefix(StartsWithStr)) {
+		FilteredObjects.Add(Exports.GetValue(Index));
 	}
 
 	return FilteredObjects;
@@ -309,19 +328,18 @@ TArray<TSharedPtr<FJsonValue>> IImporter::GetObjectsWithTypeStartingWith(const F
 
 // This is called at the end of asset creation, bringing the user to the asset and fully loading it
 bool IImporter::HandleAssetCreation(UObject* Asset) const {
-	FAssetRegistryModule::AssetCreated(Asset);
 	if (!Asset->MarkPackageDirty()) return false;
 	
 	Package->SetDirtyFlag(true);
 	Asset->PostEditChange();
-	Asset->AddToRoot();
-	
-	Package->FullyLoad();
+	FJsonImportReferences::Get().Keep(Asset);
 
-	// Browse to newly added Asset
-	const TArray<FAssetData>& Assets = {Asset};
-	const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
-	ContentBrowserModule.Get().SyncBrowserToAssets(Assets);
+	// References into this package may have been looked up (and missed) before it was imported
+	FJsonReferenceCache::Get().Invalidate(Asset->GetOutermost()->GetName());
+	FJsonTypeCache::Get().ForgetMisses();
+
+	// Registry, full load and browser sync, held back until the end of a batch
+	FJsonAssetCreationQueue::Get().Add(Asset);
 
 	return true;
 }
@@ -330,9 +348,7 @@ bool IImporter::HandleAssetCreation(UObject* Asset) const {
 template <typename T>
 TObjectPtr<T> IImporter::DownloadWrapper(TObjectPtr<T> InObject, FString Type, FString Name, FString Path) {
 	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
-	bool bEnableLocalFetch = Settings->bEnableLocalFetch;
-
-	FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
+	bool bEnableLocalFetch = Settings->bEnableLocalFetch && CVarImportMissingReferences.GetValueOnGameThread() != 0;
 
 	if (bEnableLocalFetch && (
 		InObject == nullptr ||
@@ -347,34 +363,7 @@ TObjectPtr<T> IImporter::DownloadWrapper(TObjectPtr<T> InObject, FString Type, F
 
 			// Notification
 			if (FAssetUtilities::ConstructAsset(FSoftObjectPath(Type + "'" + Path + "." + Name + "'").ToString(), Type, InObject, bRemoteDownloadStatus)) {
-				const FText AssetNameText = FText::FromString(Name);
-				const FSlateBrush* IconBrush = FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail"));
-
-				if (bRemoteDownloadStatus) {
-					AppendNotification(
-						FText::FromString("Locally Downloaded: " + Type),
-						AssetNameText,
-						2.0f,
-						IconBrush,
-						SNotificationItem::CS_Success,
-						false,
-						310.0f
-					);
-
-					MessageLogger.Message(EMessageSeverity::Info, FText::FromString("Downloaded asset: " + Name + " (" + Type + ")"));
-				} else {
-					AppendNotification(
-						FText::FromString("Download Failed: " + Type),
-						AssetNameText,
-						5.0f,
-						IconBrush,
-						SNotificationItem::CS_Fail,
-						false,
-						310.0f
-					);
-
-					MessageLogger.Error(FText::FromString("Failed to download asset: " + Name + " (" + Type + ")"));
-				}
+				FJsonImportProgress::Get().Record(bRemoteDownloadStatus ? EJsonImportEvent::Downloaded : EJsonImportEvent::DownloadFailed, Type, Name);
 			}
 		}
 	}
@@ -395,75 +384,64 @@ template void IImporter::LoadObject<USoundNode>(const TSharedPtr<FJsonObject>*,
 
 template <typename T>
 void IImporter::LoadObject(const TSharedPtr<FJsonObject>* PackageIndex, TObjectPtr<T>& Object) {
-	FString ObjectType, ObjectName, ObjectPath, Outer;
-	PackageIndex->Get()->GetStringField(TEXT("ObjectName")).Split("'", &ObjectType, &ObjectName);
-	PackageIndex->Get()->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr);
-
-	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
-
-	// Rare case of needing a GameName
-	if (!Settings->AssetSettings.GameName.IsEmpty()) {
-		ObjectPath = ObjectPath.Replace(*(Settings->AssetSettings.GameName + "/Content"), TEXT("/Game"));
-	}
-
-	ObjectPath = ObjectPath.Replace(TEXT("Engine/Content"), TEXT("/Engine"));
-	ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
-
-	if (ObjectName.Contains(".")) {
-		ObjectName.Split(".", nullptr, &ObjectName);
-	}
+	Object = ResolveObject<T>(*PackageIndex->Get(), ParentObject);
+}
 
-	if (ObjectName.Contains(".")) {
-		ObjectName.Split(".", &Outer, &ObjectName);
-	}
+template <typename T>
+TObjectPtr<T> IImporter::ResolveObject(const FJsonObject& PackageIndex, UObject* Parent) {
+	// Parsed names and load results are shared across the import session
+	FJsonReferenceCache& ReferenceCache = FJsonReferenceCache::Get();
+	const FJsonReferenceName Reference = ReferenceCache.Parse(PackageIndex);
 
 	// Try to load object using the object path and the object name combined
-	TObjectPtr<T> LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(ObjectPath + "." + ObjectName)));
+	TObjectPtr<T> LoadedObject = Cast<T>(ReferenceCache.Load(Reference.Path + "." + Reference.Name));
 
-	if (!Outer.IsEmpty())
+	// Components are looked up on the actor being imported, other parents have none
+	if (!Reference.Outer.IsEmpty())
 	{
-		AActor* NewLoadedObject = Cast<AActor>(ParentObject);
-		auto Components = NewLoadedObject->GetComponents();
-		
-		for (UActorComponent* Component : Components)
+		if (AActor* NewLoadedObject = Cast<AActor>(Parent))
 		{
-			if (ObjectName == Component->GetName())
+			auto Components = NewLoadedObject->GetComponents();
+
+			for (UActorComponent* Component : Components)
 			{
-				LoadedObject = Cast<T>(Component);
+				if (Reference.Name == Component->GetName())
+				{
+					LoadedObject = Cast<T>(Component);
+				}
 			}
 		}
 	}
 	
 	// Material Expression case
-	if (!LoadedObject && ObjectName.Contains("MaterialExpression")) {
+	if (!LoadedObject && Reference.Name.Contains("MaterialExpression")) {
 		FString AssetName;
-		ObjectPath.Split("/", nullptr, &AssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
-		LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(ObjectPath + "." + AssetName + ":" + ObjectName)));
+		Reference.Path.Split("/", nullptr, &AssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+		LoadedObject = Cast<T>(ReferenceCache.Load(Reference.Path + "." + AssetName + ":" + Reference.Name));
 	}
 
-	Object = LoadedObject;
-
-	if (!Object)
+	if (!LoadedObject)
 	{
-		Object = DownloadWrapper(LoadedObject, ObjectType, ObjectName, ObjectPath);
+		return DownloadWrapper(LoadedObject, Reference.Type, Reference.Name, Reference.Path);
 	}
+
+	return LoadedObject;
 }
 
+template TObjectPtr<UObject> IImporter::ResolveObject<UObject>(const FJsonObject&, UObject*);
+
 // Loads an array of <T> object ptrs -------------------------------------------------------
 template TArray<TObjectPtr<UCurveLinearColor>> IImporter::LoadObject<UCurveLinearColor>(const TArray<TSharedPtr<FJsonValue>>&, TArray<TObjectPtr<UCurveLinearColor>>);
 
 template <typename T>
 TArray<TObjectPtr<T>> IImporter::LoadObject(const TArray<TSharedPtr<FJsonValue>>& PackageArray, TArray<TObjectPtr<T>> Array) {
-	for (const TSharedPtr<FJsonValue>& ArrayElement : PackageArray) {
-		const TSharedPtr<FJsonObject> ObjectPtr = ArrayElement->AsObject();
+	FJsonReferenceCache& ReferenceCache = FJsonReferenceCache::Get();
 
-		FString ObjectType, ObjectName, ObjectPath;
-		ObjectPtr->GetStringField(TEXT("ObjectName")).Split("'", &ObjectType, &ObjectName);
-		ObjectPtr->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr);
-		ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
+	for (const TSharedPtr<FJsonValue>& ArrayElement : PackageArray) {
+		const FJsonReferenceName Reference = ReferenceCache.Parse(*ArrayElement->AsObject());
 
-		TObjectPtr<T> LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(ObjectPath + "." + ObjectName)));
-		Array.Add(DownloadWrapper(LoadedObject, ObjectType, ObjectName, ObjectPath));
+		TObjectPtr<T> LoadedObject = Cast<T>(ReferenceCache.Load(Reference.Path + "." + Reference.Name));
+		Array.Add(DownloadWrapper(LoadedObject, Reference.Type, Reference.Name, Reference.Path));
 	}
 
 	return Array;
@@ -472,61 +450,47 @@ TArray<TObjectPtr<T>> IImporter::LoadObject(const TArray<TSharedPtr<FJsonValue>>
 // Handles the import of an asset
 bool IImporter::ImportAssetReference(const FString& GamePath) const
 {
+	if (CVarImportMissingReferences.GetValueOnGameThread() == 0) return false;
+
 	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
 
 	FString UnSanitizedCodeName;
 	FilePath.Split(Settings->ExportDirectory.Path + "/", nullptr, &UnSanitizedCodeName);
 	UnSanitizedCodeName.Split("/", &UnSanitizedCodeName, nullptr, ESearchCase::IgnoreCase, ESearchDir::FromStart);
 
-	FString UnSanitizedPath = GamePath.Replace(TEXT("/Game/"), *(UnSanitizedCodeName + "/Content/"));
-	UnSanitizedPath = FPaths::Combine(Settings->ExportDirectory.Path, UnSanitizedPath + ".json");
+	const FString RelativePath = GamePath.Replace(TEXT("/Game/"), *(UnSanitizedCodeName + "/Content/"));
+
+	/* A lookup in the manifest, the file itself is only read by ImportReference */
+	FString UnSanitizedPath;
 
-	FString ContentBefore;
-	if (FFileHelper::LoadFileToString(ContentBefore, *UnSanitizedPath)) {
-		ImportReference(UnSanitizedPath);
-		return true;
+	if (FJsonExportManifest::Get().FindFile(RelativePath, UnSanitizedPath)) {
+		return ImportReference(UnSanitizedPath);
 	}
 
 	return false;
 }
 
 // Sends off to the ImportExports function once read
-void IImporter::ImportReference(const FString& File) const
+bool IImporter::ImportReference(const FString& File) const
 {
-	/* ----  Parse JSON into UE JSON Reader ---- */
-	FString ContentBefore;
-	FFileHelper::LoadFileToString(ContentBefore, *File);
-
-	FString Content = FString(TEXT("{\"data\": "));
-	Content.Append(ContentBefore);
-	Content.Append(FString("}"));
-
-	TSharedPtr<FJsonObject> JsonParsed;
-	const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Content);
-	/* ---------------------------------------- */
+	/* Exports reference each other, so every one of them is read before importing. Prepared files were parsed on a worker already */
+	const TSharedRef<const FJsonImportPlan> Plan = FJsonImportPipeline::Get().TakePlan(File);
 
-	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed)) {
-		const TArray<TSharedPtr<FJsonValue>> DataObjects = JsonParsed->GetArrayField(TEXT("data"));
-
-		ImportExports(DataObjects, File);
+	if (Plan->bParsed) {
+		return ImportExports(Plan->Exports, File, false, Plan->ExportIndex);
 	}
+
+	UE_LOG(LogJson, Error, TEXT("Failed to parse %s: %s"), *File, *Plan->Error);
+	return false;
 }
 
 TMap<FName, FExportData> IImporter::CreateExports() {
 	TMap<FName, FExportData> OutExports;
+	const FExportIndex& Exports = GetExportIndex();
+	OutExports.Reserve(Exports.Num());
 
-	for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
-		TSharedPtr<FJsonObject> Object = TSharedPtr<FJsonObject>(Value->AsObject());
-
-		FString ExType = Object->GetStringField(TEXT("Type"));
-		FString Name = Object->GetStringField(TEXT("Name"));
-		FString Outer = "None";
-
-		if (Object->HasField(TEXT("Outer"))) {
-			Outer = Object->GetStringField(TEXT("Outer"));
-		}
-
-		OutExports.Add(FName(Name), FExportData(ExType, Outer, Object));
+	for (int32 Index = 0; Index < Exports.Num(); Index++) {
+		OutExports.Add(FName(*Exports.GetObject(Index)->GetStringField(TEXT("Name"))), Exports.GetData(Index));
 	}
 
 	return OutExports;
@@ -543,22 +507,9 @@ void IImporter::SavePackage() const
 		return;
 	}
 
-	const FString PackageName = Package->GetName();
-	const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-
-	// User option to save packages on import
+	// User option to save packages on import, batched until the end of an import session
 	if (Settings->AssetSettings.bSavePackagesOnImport) {
-#if ENGINE_MAJOR_VERSION >= 5
-		FSavePackageArgs SaveArgs; {
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-			SaveArgs.Error = GError;
-			SaveArgs.SaveFlags = SAVE_NoError;
-		}
-		
-		UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
-#else
-		UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
-#endif
+		FJsonPackageSaveQueue::Get().Save(Package);
 	}
 }
 
@@ -580,12 +531,14 @@ FName IImporter::GetExportNameOfSubobject(const FString& PackageIndex) {
 TArray<TSharedPtr<FJsonValue>> IImporter::FilterExportsByOuter(const FString& Outer) {
 	TArray<TSharedPtr<FJsonValue>> ReturnValue = TArray<TSharedPtr<FJsonValue>>();
 
-	for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
-		const TSharedPtr<FJsonObject> ValueObject = TSharedPtr<FJsonObject>(Value->AsObject());
+	/* A name that was never made can't be any export's outer, and would look up None instead */
+	const FName OuterName(*Outer, FNAME_Find);
+	if (OuterName.IsNone()) return ReturnValue;
+
+	const FExportIndex& Exports = GetExportIndex();
 
-		FString ExOuter;
-		if (ValueObject->TryGetStringField(TEXT("Outer"), ExOuter) && ExOuter == Outer) 
-			ReturnValue.Add(TSharedPtr<FJsonValue>(Value));
+	for (const int32 Index : Exports.FindByOuter(OuterName)) {
+		ReturnValue.Add(Exports.GetValue(Index));
 	}
 
 	return ReturnValue;
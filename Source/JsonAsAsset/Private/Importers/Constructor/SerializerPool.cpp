@@ -0,0 +1,46 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Importers/Constructor/SerializerPool.h"
+
+#include "Utilities/Serializers/ObjectUtilities.h"
+#include "Utilities/Serializers/PropertyUtilities.h"
+
+FJsonSerializerPool& FJsonSerializerPool::Get() {
+	static FJsonSerializerPool Pool;
+	return Pool;
+}
+
+UObjectSerializer* FJsonSerializerPool::Acquire() {
+	check(IsInGameThread());
+
+	UObjectSerializer* Serializer;
+
+	if (Free.Num() > 0) {
+		Serializer = Free.Pop();
+	} else {
+		Serializer = NewObject<UObjectSerializer>();
+		Serializer->SetPropertySerializer(NewObject<UPropertySerializer>());
+	}
+
+	InUse.Add(Serializer);
+
+	return Serializer;
+}
+
+void FJsonSerializerPool::Release(UObjectSerializer* Serializer) {
+	check(IsInGameThread());
+
+	if (InUse.RemoveSingleSwap(Serializer) == 0) return;
+
+	Serializer->ResetForReuse();
+	Free.Add(Serializer);
+}
+
+void FJsonSerializerPool::AddReferencedObjects(FReferenceCollector& Collector) {
+	Collector.AddReferencedObjects(Free);
+	Collector.AddReferencedObjects(InUse);
+}
+
+FString FJsonSerializerPool::GetReferencerName() const {
+	return TEXT("FJsonSerializerPool");
+}
@@ -18,6 +18,7 @@
 
 #include "Editor/MaterialEditor/Private/MaterialEditor.h"
 #include "Settings/JsonAsAssetSettings.h"
+#include "Utilities/JsonEnumCache.h"
 
 #if ENGINE_MAJOR_VERSION >= 5
 #include <Editor/UnrealEd/Classes/MaterialGraph/MaterialGraphNode_Composite.h>
@@ -191,13 +192,12 @@ bool IMaterialImporter::Import() {
 	FMaterialEditor* AssetEditorInstance = nullptr;
 
 	// Handle Material Graphs
-	for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
-		TSharedPtr<FJsonObject> Object = TSharedPtr<FJsonObject>(Value->AsObject());
+	for (const int32 Index : GetExportIndex().FindByType(FName("MaterialGraph"))) {
+		TSharedPtr<FJsonObject> Object = GetExportIndex().GetObject(Index);
 
-		FString ExType = Object->GetStringField(TEXT("Type"));
 		FString Name = Object->GetStringField(TEXT("Name"));
 
-		if (ExType == "MaterialGraph" && Name != "MaterialGraph_0") {
+		if (Name != "MaterialGraph_0") {
 			TSharedPtr<FJsonObject> GraphProperties = Object->GetObjectField(TEXT("Properties"));
 			TSharedPtr<FJsonObject> SubgraphExpression;
 
@@ -369,7 +369,7 @@ bool IMaterialImporter::Import() {
 
 	FString ShadingModel;
 	if (Properties->TryGetStringField(TEXT("ShadingModel"), ShadingModel) && ShadingModel != "EMaterialShadingModel::MSM_FromMaterialExpression")
-		Material->SetShadingModel(static_cast<EMaterialShadingModel>(StaticEnum<EMaterialShadingModel>()->GetValueByNameString(ShadingModel)));
+		Material->SetShadingModel(static_cast<EMaterialShadingModel>(FJsonEnumCache::Get().GetValue(StaticEnum<EMaterialShadingModel>(), ShadingModel)));
 
 	Material->ForceRecompileForRendering();
 
@@ -4,6 +4,7 @@
 #include "Materials/MaterialInstanceConstant.h"
 #include "Utilities/MathUtilities.h"
 #include "Dom/JsonObject.h"
+#include "Utilities/JsonEnumCache.h"
 #include "RHIDefinitions.h"
 #include "MaterialShared.h"
 
@@ -19,12 +20,8 @@ bool IMaterialInstanceConstantImporter::Import() {
 		"CachedReferencedTextures"
 	}), MaterialInstanceConstant);
 
-	for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
-		TSharedPtr<FJsonObject> Object = TSharedPtr<FJsonObject>(Value->AsObject());
-
-		if (Object->GetStringField(TEXT("Type")) == "MaterialInstanceEditorOnlyData") {
-			EditorOnlyData.Add(Object);
-		}
+	for (const int32 Index : GetExportIndex().FindByType(FName("MaterialInstanceEditorOnlyData"))) {
+		EditorOnlyData.Add(GetExportIndex().GetObject(Index));
 	}
 
 	const TSharedPtr<FJsonObject>* ParentPtr;
@@ -200,7 +197,7 @@ bool IMaterialInstanceConstantImporter::Import() {
 		// Create Material Parameter Info
 		FMaterialParameterInfo MaterialParameterParameterInfo = FMaterialParameterInfo(
 			FName(Local_MaterialParameterInfo->GetStringField(TEXT("Name"))),
-			static_cast<EMaterialParameterAssociation>(StaticEnum<EMaterialParameterAssociation>()->GetValueByNameString(Local_MaterialParameterInfo->GetStringField(TEXT("Association")))),
+			static_cast<EMaterialParameterAssociation>(FJsonEnumCache::Get().GetValue(StaticEnum<EMaterialParameterAssociation>(), Local_MaterialParameterInfo->GetStringField(TEXT("Association")))),
 			Local_MaterialParameterInfo->GetIntegerField(TEXT("Index"))
 		);
 
@@ -230,7 +227,7 @@ bool IMaterialInstanceConstantImporter::Import() {
 		// Create Material Parameter Info
 		FMaterialParameterInfo MaterialParameterParameterInfo = FMaterialParameterInfo(
 			FName(Local_MaterialParameterInfo->GetStringField(TEXT("Name"))),
-			static_cast<EMaterialParameterAssociation>(StaticEnum<EMaterialParameterAssociation>()->GetValueByNameString(Local_MaterialParameterInfo->GetStringField(TEXT("Association")))),
+			static_cast<EMaterialParameterAssociation>(FJsonEnumCache::Get().GetValue(StaticEnum<EMaterialParameterAssociation>(), Local_MaterialParameterInfo->GetStringField(TEXT("Association")))),
 			Local_MaterialParameterInfo->GetIntegerField(TEXT("Index"))
 		);
 
@@ -5,6 +5,7 @@
 #include "Animation/BlendProfile.h"
 #include "Dom/JsonObject.h"
 #include "Engine/SkeletalMeshSocket.h"
+#include "Utilities/JsonEnumCache.h"
 #include "Utilities/MathUtilities.h"
 
 bool CSkeletonAssetDerived::AddVirtualBone(const FName SourceBoneName, const FName TargetBoneName, const FName VirtualBoneRootName) {
@@ -53,7 +54,7 @@ bool ISkeletonImporter::Import() {
 			continue;
 		}
 
-		int64 EnumValue = StaticEnum<EBoneTranslationRetargetingMode::Type>()->GetValueByNameString(TranslationRetargetingMode);
+		int64 EnumValue = FJsonEnumCache::Get().GetValue(StaticEnum<EBoneTranslationRetargetingMode::Type>(), TranslationRetargetingMode);
 		
 		if (EnumValue == INDEX_NONE) {
 			UE_LOG(LogTemp, Warning, TEXT("Invalid TranslationRetargetingMode: %s"), *TranslationRetargetingMode);
@@ -2,6 +2,7 @@
 
 #include "Importers/Types/Tables/CurveTableImporter.h"
 #include "Dom/JsonObject.h"
+#include "Utilities/JsonEnumCache.h"
 
 // Unfortunately these variables are private, so we had to make a "bypass" by making
 // an asset then casting to subclass that has these functions to modify them.
@@ -23,7 +24,7 @@ bool ICurveTableImporter::Import() {
 		FString CurveMode;
 		
 		if (JsonObject->TryGetStringField(TEXT("CurveTableMode"), CurveMode))
-			CurveTableMode = static_cast<ECurveTableMode>(StaticEnum<ECurveTableMode>()->GetValueByNameString(CurveMode));
+			CurveTableMode = static_cast<ECurveTableMode>(FJsonEnumCache::Get().GetValue(StaticEnum<ECurveTableMode>(), CurveMode));
 
 		DerivedCurveTable->ChangeTableMode(CurveTableMode);
 	}
@@ -49,15 +50,15 @@ bool ICurveTableImporter::Import() {
 
 						RichKey.InterpMode =
 							static_cast<ERichCurveInterpMode>(
-								StaticEnum<ERichCurveInterpMode>()->GetValueByNameString(Key->GetStringField(TEXT("InterpMode")))
+								FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveInterpMode>(), Key->GetStringField(TEXT("InterpMode")))
 							);
 						RichKey.TangentMode =
 							static_cast<ERichCurveTangentMode>(
-								StaticEnum<ERichCurveTangentMode>()->GetValueByNameString(Key->GetStringField(TEXT("TangentMode")))
+								FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveTangentMode>(), Key->GetStringField(TEXT("TangentMode")))
 							);
 						RichKey.TangentWeightMode =
 							static_cast<ERichCurveTangentWeightMode>(
-								StaticEnum<ERichCurveTangentWeightMode>()->GetValueByNameString(Key->GetStringField(TEXT("TangentWeightMode")))
+								FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveTangentWeightMode>(), Key->GetStringField(TEXT("TangentWeightMode")))
 							);
 
 						RichKey.ArriveTangent = Key->GetNumberField(TEXT("ArriveTangent"));
@@ -74,7 +75,7 @@ bool ICurveTableImporter::Import() {
 			// Method of Interpolation
 			NewSimpleCurve.InterpMode =
 				static_cast<ERichCurveInterpMode>(
-					StaticEnum<ERichCurveInterpMode>()->GetValueByNameString(CurveData->GetStringField(TEXT("InterpMode")))
+					FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveInterpMode>(), CurveData->GetStringField(TEXT("InterpMode")))
 				);
 
 			const TArray<TSharedPtr<FJsonValue>>* KeysPtr;
@@ -91,11 +92,11 @@ bool ICurveTableImporter::Import() {
 		RealCurve.SetDefaultValue(CurveData->GetNumberField(TEXT("DefaultValue")));
 		RealCurve.PreInfinityExtrap = 
 			static_cast<ERichCurveExtrapolation>(
-				StaticEnum<ERichCurveExtrapolation>()->GetValueByNameString(CurveData->GetStringField(TEXT("PreInfinityExtrap")))
+				FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveExtrapolation>(), CurveData->GetStringField(TEXT("PreInfinityExtrap")))
 			);
 		RealCurve.PostInfinityExtrap =
 			static_cast<ERichCurveExtrapolation>(
-				StaticEnum<ERichCurveExtrapolation>()->GetValueByNameString(CurveData->GetStringField(TEXT("PostInfinityExtrap")))
+				FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveExtrapolation>(), CurveData->GetStringField(TEXT("PostInfinityExtrap")))
 			);
 
 		// Update Curve Table
@@ -2,6 +2,7 @@
 
 #include "Importers/Types/Tables/DataTableImporter.h"
 #include "Dom/JsonObject.h"
+#include "Utilities/JsonTypeCache.h"
 
 // Shout-out to UEAssetToolkit
 bool IDataTableImporter::Import() {
@@ -19,7 +20,7 @@ bool IDataTableImporter::Import() {
 	}
 
 	// Find Table Row Struct
-	UScriptStruct* TableRowStruct = FindObject<UScriptStruct>(ANY_PACKAGE, *TableStruct); {
+	UScriptStruct* TableRowStruct = FJsonTypeCache::Get().Find<UScriptStruct>(TableStruct); {
 		if (TableRowStruct == NULL) {
 			AppendNotification(FText::FromString("DataTable Missing: " + TableStruct), FText::FromString(FileName), 2.0f, SNotificationItem::CS_Fail, true, 350.0f);
 
@@ -1,8 +1,9 @@
-// Copyright JAA Contributors 2024-2025
+﻿// Copyright JAA Contributors 2024-2025
 
 #include "JsonAsAsset.h"
 
 #include "./Importers/Constructor/Importer.h"
+#include "./Importers/Constructor/ImportPipeline.h"
 
 // ------------------------------------------------------------------------------------------------------------>
 
@@ -24,9 +25,13 @@
 #include "Settings/JsonAsAssetSettings.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 #include "IMessageLogListing.h"
 #include "ISettingsModule.h"
 #include "MessageLogModule.h"
+#include "Misc/ScopedSlowTask.h"
 #include "Styling/SlateIconFinder.h"
 
 // Settings
@@ -36,6 +41,14 @@
 #include "Modules/UI/CommandsModule.h"
 #include "Modules/UI/StyleModule.h"
 #include "Utilities/AppStyleCompatibility.h"
+#include "Utilities/JsonArena.h"
+#include "Utilities/JsonAssetCreationQueue.h"
+#include "Utilities/JsonExportManifest.h"
+#include "Utilities/JsonImportProgress.h"
+#include "Utilities/JsonImportReferences.h"
+#include "Utilities/JsonReferenceCache.h"
+#include "Utilities/JsonTypeCache.h"
+#include "Utilities/JsonPackageSaveQueue.h"
 // <------------------------------------------------------------------------------------------------------------
 
 #ifdef _MSC_VER
@@ -44,6 +57,13 @@
 
 #define LOCTEXT_NAMESPACE "FJsonAsAssetModule"
 
+static TAutoConsoleVariable<int32> CVarFolderPlanBudget(
+	TEXT("JsonAsAsset.FolderPlanBudgetMB"),
+	128,
+	TEXT("Import Folder keeps every file it parsed while finding references when the folder holds at most this many MB of JSON, larger folders are parsed again file by file as they're imported."),
+	ECVF_Default
+);
+
 #if PLATFORM_WINDOWS
     static TWeakPtr<SNotificationItem> ImportantNotificationPtr;
     static TWeakPtr<SNotificationItem> LocalFetchNotificationPtr;
@@ -126,16 +146,210 @@ void FJsonAsAssetModule::PluginButtonClicked() {
 	if (OutFileNames.Num() == 0)
 		return;
 
-	for (FString& File : OutFileNames) {
-		// Clear Message Log
-		FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
-		TSharedRef<IMessageLogListing> LogListing = (MessageLogModule.GetLogListing("JsonAsAsset"));
-		LogListing->ClearMessages();
+	// Read and parse every file on worker threads, while the first ones are being imported
+	FJsonImportPipeline& Pipeline = FJsonImportPipeline::Get();
+	Pipeline.Prepare(OutFileNames);
+
+	// Clear Message Log once, every file gets a page of its own
+	FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
+	TSharedRef<IMessageLogListing> LogListing = (MessageLogModule.GetLogListing("JsonAsAsset"));
+	LogListing->ClearMessages();
+
+	FScopedSlowTask SlowTask(OutFileNames.Num() + 1, LOCTEXT("ImportingFiles", "Importing JSON files..."));
+	SlowTask.MakeDialog(true);
+
+	// Files referenced by other selected files are imported first
+	SlowTask.EnterProgressFrame(1, LOCTEXT("ParsingFiles", "Parsing JSON files..."));
+	const TArray<FString> SortedFiles = Pipeline.SortByDependencies(OutFileNames);
+
+	const int32 NumImported = ImportFiles({ SortedFiles }, SlowTask);
+
+	if (NumImported < SortedFiles.Num()) {
+		UE_LOG(LogJson, Warning, TEXT("Import cancelled, %d of %d files were imported"), NumImported, SortedFiles.Num());
+	}
+
+	Pipeline.Reset();
+}
+
+void FJsonAsAssetModule::ImportFolder() {
+	Settings = GetMutableDefault<UJsonAsAssetSettings>();
+
+	const TArray<FString> Folders = OpenFolderDialog("Import Folder");
+	if (Folders.Num() == 0)
+		return;
+
+	TArray<FString> Files;
+	int64 TotalSize = 0;
+
+	IFileManager::Get().IterateDirectoryStatRecursively(*Folders[0], [&Files, &TotalSize](const TCHAR* Path, const FFileStatData& StatData) {
+		if (!StatData.bIsDirectory && FPaths::GetExtension(Path).Equals(TEXT("json"), ESearchCase::IgnoreCase)) {
+			Files.Add(Path);
+			TotalSize += StatData.FileSize;
+		}
+
+		return true;
+	});
+
+	if (Files.Num() == 0) {
+		UE_LOG(LogJson, Warning, TEXT("No JSON files found in %s"), *Folders[0]);
+		return;
+	}
+
+	Files.Sort();
+
+	FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
+	TSharedRef<IMessageLogListing> LogListing = (MessageLogModule.GetLogListing("JsonAsAsset"));
+	LogListing->ClearMessages();
+
+	// Indexing, then a frame per file to find its references and another to import it
+	FScopedSlowTask SlowTask(Files.Num() * 2 + 1, LOCTEXT("ImportingFolder", "Importing folder..."));
+	SlowTask.MakeDialog(true);
+
+	// References are found through the manifest, it has to know every export file first
+	SlowTask.EnterProgressFrame(1, LOCTEXT("IndexingExports", "Indexing export directory..."));
+
+	FJsonExportManifest& Manifest = FJsonExportManifest::Get();
+	Manifest.Refresh();
+
+	while (Manifest.IsBuilding()) {
+		if (SlowTask.ShouldCancel())
+			return;
+
+		SlowTask.TickProgress();
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	if (!Manifest.IsReady()) {
+		UE_LOG(LogJson, Warning, TEXT("The export directory isn't set or doesn't exist, files in %s are imported without looking at their references"), *Folders[0]);
+	}
+
+	// Parent materials before their instances, functions before materials, enums before tables...
+	FJsonImportPipeline& Pipeline = FJsonImportPipeline::Get();
+
+	const int32 NumWorkers = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	const bool bKeepPlans = TotalSize <= static_cast<int64>(CVarFolderPlanBudget.GetValueOnGameThread()) * 1024 * 1024;
+
+	TArray<TArray<FString>> References;
+	References.Reserve(Files.Num());
+
+	if (bKeepPlans) {
+		// Every file is parsed once on the workers, and imported from that plan later on
+		Pipeline.Prepare(Files, false);
+
+		for (int32 Index = 0; Index < Files.Num(); Index++) {
+			if (SlowTask.ShouldCancel()) {
+				Pipeline.Reset();
+				return;
+			}
+
+			SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("FindingReferences", "Finding references between files ({0}/{1})"), Index + 1, Files.Num()));
+			References.Add(Pipeline.PeekPlan(Files[Index])->References);
+		}
+	} else {
+		// Too much to hold at once, only references are kept and files are parsed again as they're imported
+		int32 NumScanned = 0;
+
+		References = FJsonImportPipeline::FindReferences(Files, NumWorkers * 4, [&SlowTask, &NumScanned, &Files](const int32 NumNowScanned) {
+			SlowTask.EnterProgressFrame(NumNowScanned - NumScanned, FText::Format(LOCTEXT("FindingReferences", "Finding references between files ({0}/{1})"), NumNowScanned, Files.Num()));
+			NumScanned = NumNowScanned;
+
+			return !SlowTask.ShouldCancel();
+		});
+
+		if (SlowTask.ShouldCancel())
+			return;
+	}
+
+	const TArray<TArray<FString>> Waves = FJsonImportPipeline::SortIntoWaves(Files, References);
+
+	// Keep a few files per worker parsing ahead of the one being imported
+	const int32 NumImported = ImportFiles(Waves, SlowTask, NumWorkers * 2);
+
+	Pipeline.Reset();
+
+	UE_LOG(LogJson, Log, TEXT("Imported %d of %d files from %s in %d waves"), NumImported, Files.Num(), *Folders[0], Waves.Num());
+}
+
+int32 FJsonAsAssetModule::ImportFiles(const TArray<TArray<FString>>& Waves, FScopedSlowTask& SlowTask, const int32 PrefetchWindow) {
+	TArray<FString> Files;
+
+	for (const TArray<FString>& Wave : Waves) {
+		Files.Append(Wave);
+	}
+
+	FJsonImportPipeline& Pipeline = FJsonImportPipeline::Get();
+
+	if (PrefetchWindow > 0) {
+		Pipeline.Prepare(TArray<FString>(Files.GetData(), FMath::Min(PrefetchWindow, Files.Num())), false);
+	}
+
+	// Packages are saved together once their dependency wave is imported
+	FJsonPackageSaveQueue& SaveQueue = FJsonPackageSaveQueue::Get();
+	SaveQueue.BeginSession();
+
+	// One progress notification for the batch, message log lines are written together at the end
+	FJsonImportProgress& Progress = FJsonImportProgress::Get();
+	Progress.BeginSession(Files.Num());
+
+	// The asset registry hears about everything at once, and the browser only moves to what was asked for
+	FJsonAssetCreationQueue& CreationQueue = FJsonAssetCreationQueue::Get();
+	CreationQueue.BeginSession();
+
+	// Imported assets are held until their wave is done instead of being rooted for good
+	FJsonImportReferences& References = FJsonImportReferences::Get();
+	References.BeginSession();
+
+	// The same references show up in file after file, each is parsed and looked up once
+	FJsonReferenceCache& ReferenceCache = FJsonReferenceCache::Get();
+	ReferenceCache.BeginSession();
+
+	int32 NumImported = 0;
+
+	int32 WaveIndex = 0;
+	int32 WaveEnd = Waves.Num() > 0 ? Waves[0].Num() : 0;
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		if (SlowTask.ShouldCancel())
+			break;
+
+		if (PrefetchWindow > 0 && Files.IsValidIndex(Index + PrefetchWindow)) {
+			Pipeline.Prepare({ Files[Index + PrefetchWindow] }, false);
+		}
+
+		const FString& File = Files[Index];
+
+		const FText FileName = FText::FromString(FPaths::GetBaseFilename(File));
+		SlowTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ImportingFile", "Importing {0} ({1}/{2})"), FileName, Index + 1, Files.Num()));
 
 		// Import asset by IImporter
-		IImporter* Importer = new IImporter();
-		Importer->ImportReference(File);
+		Progress.BeginFile(File);
+
+		IImporter Importer;
+		Importer.ImportReference(File);
+
+		CreationQueue.MarkRoot();
+		Progress.FinishFile();
+		NumImported++;
+
+		if (NumImported == WaveEnd) {
+			References.FinishWave(Waves[WaveIndex].Num());
+
+			if (Waves.IsValidIndex(++WaveIndex)) {
+				WaveEnd += Waves[WaveIndex].Num();
+			}
+		}
 	}
+
+	ReferenceCache.EndSession();
+	References.EndSession();
+	CreationQueue.EndSession();
+	Progress.EndSession();
+
+	// Whatever was imported before a cancel is still saved
+	SlowTask.EnterProgressFrame(0, LOCTEXT("SavingPackages", "Saving packages..."));
+	FJsonPackageSaveQueue::LogReport(SaveQueue.EndSession());
+
+	return NumImported;
 }
 
 void FJsonAsAssetModule::StartupModule() {
@@ -241,6 +455,8 @@ void FJsonAsAssetModule::StartupModule() {
     // Register custom class layout for settings
     FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
     PropertyModule.RegisterCustomClassLayout(UJsonAsAssetSettings::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FJsonAsAssetSettingsDetails::MakeInstance));
+	// Index the export directory in the background, references are resolved against it
+	FJsonExportManifest::Get().Initialize();
 }
 
 void FJsonAsAssetModule::ShutdownModule() {
@@ -248,6 +464,9 @@ void FJsonAsAssetModule::ShutdownModule() {
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
 
+	FJsonExportManifest::Get().Shutdown();
+	FJsonTypeCache::Get().Shutdown();
+
 	// Shutdown the plugin style and unregister commands
 	FJsonAsAssetStyle::Shutdown();
 	FJsonAsAssetCommands::Unregister();
@@ -391,6 +610,19 @@ TSharedRef<SWidget> FJsonAsAssetModule::CreateToolbarDropdown() {
 			FSlateIcon(FAppStyle::Get().GetStyleSetName(), "LevelEditor.Tabs.Viewports")
 		);
 
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("JsonAsAssetImportFolderButton", "Import Folder"),
+			LOCTEXT("JsonAsAssetImportFolderButtonTooltip", "Imports every JSON file in a folder, files referenced by others first"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.FolderOpen"),
+			FUIAction(
+				FExecuteAction::CreateRaw(this, &FJsonAsAssetModule::ImportFolder),
+				FCanExecuteAction::CreateLambda([this]() {
+					return !Settings->ExportDirectory.Path.IsEmpty();
+				})
+			),
+			NAME_None
+		);
+
 		MenuBuilder.AddMenuEntry(
 		LOCTEXT("JsonAsAssetDocumentationButton", "Documentation"),
 		LOCTEXT("JsonAsAssetDocumentationButtonTooltip", "View JsonAsAsset documentation"),
@@ -678,56 +910,42 @@ void FJsonAsAssetModule::ImportConvexCollision() const
 			if (FPaths::FileExists(JsonFilePath)) {
 				UE_LOG(LogTemp, Log, TEXT("Found JSON file for Static Mesh: %s"), *JsonFilePath);
 
-				FString ContentBefore;
-				if (FFileHelper::LoadFileToString(ContentBefore, *JsonFilePath)) {
-					FString Content = FString(TEXT("{\"data\": "));
-					Content.Append(ContentBefore);
-					Content.Append(FString("}"));
-
-					TSharedPtr<FJsonObject> JsonParsed;
-					const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Content);
-
-					if (FJsonSerializer::Deserialize(JsonReader, JsonParsed)) {
-						const TArray<TSharedPtr<FJsonValue>> DataObjects = JsonParsed->GetArrayField(TEXT("data"));
-
-						for (const TSharedPtr<FJsonValue>& DataObject : DataObjects) {
-							if (!DataObject.IsValid() || !DataObject->AsObject().IsValid()) {
-								continue;
-							}
-
-							TSharedPtr<FJsonObject> JsonObject = DataObject->AsObject();
-							FString TypeValue;
-
-							// Check if the "Type" field exists and matches "BodySetup"
-							if (JsonObject->TryGetStringField(TEXT("Type"), TypeValue) && TypeValue == "BodySetup") {
-								// Check for "Class" with value "UScriptClass'BodySetup'"
-								FString ClassValue;
-								if (JsonObject->TryGetStringField(TEXT("Class"), ClassValue) && ClassValue == "UScriptClass'BodySetup'") {
-									// Navigate to "Properties"
-									TSharedPtr<FJsonObject> PropertiesObject = JsonObject->GetObjectField(TEXT("Properties"));
-									if (PropertiesObject.IsValid()) {
-										// Navigate to "AggGeom"
-										TSharedPtr<FJsonObject> AggGeomObject = PropertiesObject->GetObjectField(TEXT("AggGeom"));
-										if (AggGeomObject.IsValid()) {
-											FKAggregateGeom AggGeom;
-
-											GObjectSerializer->DeserializeObjectProperties(PropertiesObject, StaticMesh->GetBodySetup());
-											StaticMesh->GetBodySetup()->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseDefault;
-											StaticMesh->MarkPackageDirty();
-											StaticMesh->GetBodySetup()->PostEditChange();
-											StaticMesh->Modify(true);
-
-											// Notification
-											AppendNotification(
-												FText::FromString("Imported Convex Collision: " + StaticMeshName),
-												FText::FromString(StaticMeshName),
-												3.5f,
-												FAppStyle::GetBrush("PhysicsAssetEditor.EnableCollision.Small"),
-												SNotificationItem::CS_Success,
-												false,
-												310.0f
-											);
-										}
+				/* Only BodySetup exports are needed, the rest of the file stays in the arena and is never converted */
+				FJsonArenaDocument Document;
+
+				if (Document.ParseFile(JsonFilePath)) {
+					for (const FJsonArenaNode& DataObject : Document.GetRoot().GetElements()) {
+						FString TypeValue;
+
+						// Check if the "Type" field exists and matches "BodySetup"
+						if (DataObject.TryGetString(TEXT("Type"), TypeValue) && TypeValue == "BodySetup") {
+							// Check for "Class" with value "UScriptClass'BodySetup'"
+							FString ClassValue;
+							if (DataObject.TryGetString(TEXT("Class"), ClassValue) && ClassValue == "UScriptClass'BodySetup'") {
+								// Navigate to "Properties"
+								const FJsonArenaNode* Properties = DataObject.Find(TEXT("Properties"));
+								if (Properties != nullptr && Properties->IsObject()) {
+									// Navigate to "AggGeom"
+									const FJsonArenaNode* AggGeom = Properties->Find(TEXT("AggGeom"));
+									if (AggGeom != nullptr && AggGeom->IsObject()) {
+										TSharedPtr<FJsonObject> PropertiesObject = FJsonArenaDocument::ToJsonObject(*Properties);
+
+										GObjectSerializer->DeserializeObjectProperties(PropertiesObject, StaticMesh->GetBodySetup());
+										StaticMesh->GetBodySetup()->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseDefault;
+										StaticMesh->MarkPackageDirty();
+										StaticMesh->GetBodySetup()->PostEditChange();
+										StaticMesh->Modify(true);
+
+										// Notification
+										AppendNotification(
+											FText::FromString("Imported Convex Collision: " + StaticMeshName),
+											FText::FromString(StaticMeshName),
+											3.5f,
+											FAppStyle::GetBrush("PhysicsAssetEditor.EnableCollision.Small"),
+											SNotificationItem::CS_Success,
+											false,
+											310.0f
+										);
 									}
 								}
 							}
@@ -12,7 +12,11 @@
 #include "Settings/JsonAsAssetSettings.h"
 #include "Dom/JsonObject.h"
 
-#include "UObject/SavePackage.h"
+#include "Utilities/JsonAssetCreationQueue.h"
+#include "Utilities/JsonImportReferences.h"
+#include "Utilities/JsonPackageSaveQueue.h"
+#include "Utilities/JsonReferenceCache.h"
+#include "Utilities/JsonTypeCache.h"
 
 #include "HttpModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -125,7 +129,7 @@ bool FAssetUtilities::ConstructAsset(const FString& Path, const FString& Type, T
 		return false;
 	}
 
-	UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type);
+	UClass* Class = FJsonTypeCache::Get().Find<UClass>(Type);
 
 	if (Class == nullptr) return false;
 	bool bDataAsset = Class->IsChildOf(UDataAsset::StaticClass());
@@ -192,8 +196,8 @@ bool FAssetUtilities::ConstructAsset(const FString& Path, const FString& Type, T
 				Package->FullyLoad();
 
 				// Import asset by IImporter
-				IImporter* Importer = new IImporter();
-				bSuccess = Importer->ImportExports(Response->GetArrayField(TEXT("jsonOutput")), PackagePath, true);
+				IImporter Importer;
+				bSuccess = Importer.ImportExports(Response->GetArrayField(TEXT("jsonOutput")), PackagePath, true);
 
 				// Define found object
 				OutObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *Path));
@@ -281,32 +285,20 @@ bool FAssetUtilities::Construct_TypeTexture(const FString& Path, const FString&
 	if (Texture == nullptr)
 		return false;
 
-	FAssetRegistryModule::AssetCreated(Texture);
 	if (!Texture->MarkPackageDirty())
 		return false;
 
 	Package->SetDirtyFlag(true);
 	Texture->PostEditChange();
-	Texture->AddToRoot();
-	Package->FullyLoad();
+	FJsonImportReferences::Get().Keep(Texture);
+	FJsonReferenceCache::Get().Invalidate(Package->GetName());
+
+	// Registered along with the rest of the batch, the importer that asked for it is what the user sees
+	FJsonAssetCreationQueue::Get().Add(Texture, false);
 
 	// Save texture
 	if (Settings->AssetSettings.bSavePackagesOnImport)
-	{
-		FSavePackageArgs SaveArgs;
-		{
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-			SaveArgs.SaveFlags = SAVE_NoError;
-		}
-
-		const FString PackageName = Package->GetName();
-		const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-#if ENGINE_MAJOR_VERSION >= 5
-		UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
-#else
-		UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
-#endif
-	}
+		FJsonPackageSaveQueue::Get().Save(Package);
 
 	OutTexture = Texture;
 
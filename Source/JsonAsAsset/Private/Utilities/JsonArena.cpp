@@ -0,0 +1,349 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonArena.h"
+
+#include "JsonGlobals.h"
+#include "Utilities/JsonParsers.h"
+
+FJsonArena::~FJsonArena() {
+	Reset();
+}
+
+void* FJsonArena::Allocate(const SIZE_T Size, const SIZE_T Alignment) {
+	uint8* Aligned = Align(Cursor, Alignment);
+
+	if (Cursor == nullptr || Aligned + Size > BlockEnd) {
+		/* Anything large gets a block of its own */
+		const SIZE_T NewBlockSize = FMath::Max<SIZE_T>(BlockSize, Size + Alignment);
+
+		uint8* Block = static_cast<uint8*>(FMemory::Malloc(NewBlockSize));
+		Blocks.Add(Block);
+
+		AllocatedSize += NewBlockSize;
+
+		if (NewBlockSize > BlockSize) {
+			return Align(Block, Alignment);
+		}
+
+		Cursor = Block;
+		BlockEnd = Block + NewBlockSize;
+
+		Aligned = Align(Cursor, Alignment);
+	}
+
+	Cursor = Aligned + Size;
+	return Aligned;
+}
+
+void FJsonArena::Reset() {
+	for (uint8* Block : Blocks) {
+		FMemory::Free(Block);
+	}
+
+	Blocks.Empty();
+
+	Cursor = nullptr;
+	BlockEnd = nullptr;
+	AllocatedSize = 0;
+}
+
+TArrayView<const FJsonArenaNode> FJsonArenaNode::GetElements() const {
+	return Type == EJsonArenaType::Array ? TArrayView<const FJsonArenaNode>(Elements, Num) : TArrayView<const FJsonArenaNode>();
+}
+
+TArrayView<const FJsonArenaField> FJsonArenaNode::GetFields() const {
+	return Type == EJsonArenaType::Object ? TArrayView<const FJsonArenaField>(Fields, Num) : TArrayView<const FJsonArenaField>();
+}
+
+const FJsonArenaNode* FJsonArenaNode::Find(const FName Key) const {
+	if (Type != EJsonArenaType::Object) return nullptr;
+
+	int32 Low = 0;
+	int32 High = Num;
+
+	while (Low < High) {
+		const int32 Middle = Low + (High - Low) / 2;
+
+		if (Fields[Middle].Key.FastLess(Key)) {
+			Low = Middle + 1;
+		} else {
+			High = Middle;
+		}
+	}
+
+	if (Low == Num || Fields[Low].Key != Key) return nullptr;
+
+	/* Fields sharing the FName only differ in case, the one written like Key is meant */
+	if (Low + 1 < Num && Fields[Low + 1].Key == Key) {
+		const FString KeyText = Key.ToString();
+
+		for (int32 Index = Low; Index < Num && Fields[Index].Key == Key; Index++) {
+			if (FCString::Strcmp(Fields[Index].KeyText, *KeyText) == 0) return &Fields[Index].Value;
+		}
+
+		return nullptr;
+	}
+
+	return &Fields[Low].Value;
+}
+
+bool FJsonArenaNode::TryGetString(const FName Key, FString& OutString) const {
+	const FJsonArenaNode* Value = Find(Key);
+	if (Value == nullptr || Value->Type != EJsonArenaType::String) return false;
+
+	OutString = Value->AsString();
+	return true;
+}
+
+namespace {
+	struct FJsonArenaKey {
+		FName Name;
+		const TCHAR* Text;
+		int32 Length;
+	};
+
+	/* Same key and same case */
+	bool IsSameKey(const FJsonArenaField& A, const FJsonArenaField& B) {
+		return A.Key == B.Key && FCString::Strcmp(A.KeyText, B.KeyText) == 0;
+	}
+
+	/* Builds FJsonArenaNodes, keys are interned as FNames and kept as written */
+	struct FJsonArenaBuilder {
+		typedef FJsonArenaNode FValue;
+		typedef FJsonArenaKey FKey;
+
+		explicit FJsonArenaBuilder(FJsonArena& Arena)
+			: Arena(Arena)
+		{
+		}
+
+		FJsonArena& Arena;
+
+		/* Fields and elements of every object and array still being parsed */
+		TArray<FJsonArenaField> Fields;
+		TArray<FJsonArenaNode> Elements;
+
+		TArray<TCHAR> KeyBuffer;
+
+		/* Text of the first casing seen for each key, keys repeat in every export */
+		TMap<FName, const TCHAR*> KeyTexts;
+
+		FValue MakeNull() {
+			return FJsonArenaNode();
+		}
+
+		FValue MakeBoolean(const bool bValue) {
+			FJsonArenaNode Node;
+			Node.Type = EJsonArenaType::Boolean;
+			Node.bBoolean = bValue;
+
+			return Node;
+		}
+
+		FValue MakeNumber(const double Number) {
+			FJsonArenaNode Node;
+			Node.Type = EJsonArenaType::Number;
+			Node.Number = Number;
+
+			return Node;
+		}
+
+		FValue MakeString(const ANSICHAR* UTF8, const int32 Length) {
+			const FUTF8ToTCHAR Converted(UTF8, Length);
+
+			TCHAR* String = Arena.AllocateArray<TCHAR>(Converted.Length() + 1);
+			FMemory::Memcpy(String, Converted.Get(), Converted.Length() * sizeof(TCHAR));
+			String[Converted.Length()] = TEXT('\0');
+
+			FJsonArenaNode Node;
+			Node.Type = EJsonArenaType::String;
+			Node.Num = Converted.Length();
+			Node.String = String;
+
+			return Node;
+		}
+
+		FKey MakeKey(const ANSICHAR* UTF8, const int32 Length) {
+			const FUTF8ToTCHAR Converted(UTF8, Length);
+
+			KeyBuffer.Reset();
+			KeyBuffer.Append(Converted.Get(), Converted.Length());
+			KeyBuffer.Add(TEXT('\0'));
+
+			FJsonArenaKey Key;
+			Key.Name = FName(KeyBuffer.GetData());
+			Key.Length = Converted.Length();
+
+			const TCHAR** Known = KeyTexts.Find(Key.Name);
+
+			if (Known != nullptr && FCString::Strcmp(*Known, KeyBuffer.GetData()) == 0) {
+				Key.Text = *Known;
+				return Key;
+			}
+
+			TCHAR* Text = Arena.AllocateArray<TCHAR>(KeyBuffer.Num());
+			FMemory::Memcpy(Text, KeyBuffer.GetData(), KeyBuffer.Num() * sizeof(TCHAR));
+
+			if (Known == nullptr) {
+				KeyTexts.Add(Key.Name, Text);
+			}
+
+			Key.Text = Text;
+			return Key;
+		}
+
+		int32 BeginObject() const { return Fields.Num(); }
+
+		void AddField(FKey&& Key, FValue&& Value) {
+			FJsonArenaField& Field = Fields.AddDefaulted_GetRef();
+			Field.Key = Key.Name;
+			Field.KeyText = Key.Text;
+			Field.KeyLength = Key.Length;
+			Field.Value = Value;
+		}
+
+		FValue EndObject(const int32 Marker) {
+			const int32 Count = Fields.Num() - Marker;
+
+			FJsonArenaField* Sorted = Arena.AllocateArray<FJsonArenaField>(Count);
+			int32 Unique = 0;
+
+			if (Count > 0) {
+				TArrayView<FJsonArenaField> View(Fields.GetData() + Marker, Count);
+
+				/* Casings of one key sit next to each other */
+				View.StableSort([](const FJsonArenaField& A, const FJsonArenaField& B) {
+					if (A.Key != B.Key) return A.Key.FastLess(B.Key);
+
+					return FCString::Strcmp(A.KeyText, B.KeyText) < 0;
+				});
+
+				/* A key written twice keeps the last value, same as FJsonObject::SetField */
+				for (const FJsonArenaField& Field : View) {
+					if (Unique > 0 && IsSameKey(Sorted[Unique - 1], Field)) {
+						Sorted[Unique - 1].Value = Field.Value;
+					} else {
+						new (&Sorted[Unique++]) FJsonArenaField(Field);
+					}
+				}
+			}
+
+			JsonParsers::Truncate(Fields, Marker);
+
+			FJsonArenaNode Node;
+			Node.Type = EJsonArenaType::Object;
+			Node.Num = Unique;
+			Node.Fields = Sorted;
+
+			return Node;
+		}
+
+		int32 BeginArray() const { return Elements.Num(); }
+
+		void AddElement(FValue&& Value) {
+			Elements.Add(Value);
+		}
+
+		FValue EndArray(const int32 Marker) {
+			FJsonArenaNode Node;
+			Node.Type = EJsonArenaType::Array;
+			Node.Num = Elements.Num() - Marker;
+			Node.Elements = CopyElements(Marker);
+
+			return Node;
+		}
+
+		const FJsonArenaNode* CopyElements(const int32 Marker) {
+			const int32 Count = Elements.Num() - Marker;
+
+			FJsonArenaNode* Copy = Arena.AllocateArray<FJsonArenaNode>(Count);
+
+			if (Count > 0) {
+				FMemory::Memcpy(Copy, Elements.GetData() + Marker, Count * sizeof(FJsonArenaNode));
+			}
+
+			JsonParsers::Truncate(Elements, Marker);
+
+			return Copy;
+		}
+	};
+}
+
+bool FJsonArenaDocument::Parse(const uint8* Data, const int64 Size, FString* OutError, const EJsonReaderBackend Backend) {
+	Reset();
+
+	FJsonArenaBuilder Builder(Arena);
+	FString Error;
+
+	/* Exports are collected on the builder's element stack, the root array is the one value left on it */
+	const bool bSuccess = JsonParsers::ParseRootArray(Data, Size, Builder, FJsonStreamReader::UseStructuralIndex(Backend), [&Builder](FJsonArenaNode&& Element) {
+		Builder.AddElement(MoveTemp(Element));
+		return true;
+	}, Error);
+
+	if (!bSuccess) {
+		if (OutError != nullptr) {
+			*OutError = MoveTemp(Error);
+		}
+
+		Reset();
+		return false;
+	}
+
+	Root = Builder.EndArray(0);
+	return true;
+}
+
+bool FJsonArenaDocument::ParseFile(const FString& FilePath, FString* OutError) {
+	/* Nodes own copies of everything they hold, the file can be unmapped as soon as it's parsed */
+	FJsonFileView File;
+	if (!File.Open(FilePath, OutError)) return false;
+
+	return Parse(File.GetData(), File.Num(), OutError);
+}
+
+void FJsonArenaDocument::Reset() {
+	Arena.Reset();
+	Root = FJsonArenaNode();
+}
+
+TSharedPtr<FJsonValue> FJsonArenaDocument::ToJsonValue(const FJsonArenaNode& Node) {
+	switch (Node.Type) {
+		case EJsonArenaType::Boolean: return MakeShared<FJsonValueBoolean>(Node.bBoolean);
+		case EJsonArenaType::Number: return MakeShared<FJsonValueNumber>(Node.Number);
+		case EJsonArenaType::String: return MakeShared<FJsonValueString>(Node.AsString());
+
+		case EJsonArenaType::Array: {
+			TArray<TSharedPtr<FJsonValue>> Array;
+			Array.Reserve(Node.Num);
+
+			for (const FJsonArenaNode& Element : Node.GetElements()) {
+				Array.Add(ToJsonValue(Element));
+			}
+
+			return MakeShared<FJsonValueArray>(Array);
+		}
+
+		case EJsonArenaType::Object: return MakeShared<FJsonValueObject>(ToJsonObject(Node));
+
+		default: return MakeShared<FJsonValueNull>();
+	}
+}
+
+TSharedPtr<FJsonObject> FJsonArenaDocument::ToJsonObject(const FJsonArenaNode& Node) {
+	TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->Values.Reserve(Node.Num);
+
+	const TArrayView<const FJsonArenaField> Fields = Node.GetFields();
+
+	for (int32 Index = 0; Index < Fields.Num(); Index++) {
+		/* FJsonObject ignores case in keys, only one of the casings can make it */
+		if (Index > 0 && Fields[Index - 1].Key == Fields[Index].Key) {
+			UE_LOG(LogJson, Warning, TEXT("JSON keys \"%s\" and \"%s\" only differ in case, keeping the value of \"%s\""), Fields[Index - 1].KeyText, Fields[Index].KeyText, Fields[Index].KeyText);
+		}
+
+		Object->Values.Add(Fields[Index].GetKey(), ToJsonValue(Fields[Index].Value));
+	}
+
+	return Object;
+}
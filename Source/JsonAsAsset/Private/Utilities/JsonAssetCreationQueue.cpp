@@ -0,0 +1,104 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonAssetCreationQueue.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ContentBrowserModule.h"
+#include "IContentBrowserSingleton.h"
+
+FJsonAssetCreationQueue& FJsonAssetCreationQueue::Get() {
+	static FJsonAssetCreationQueue Queue;
+	return Queue;
+}
+
+void FJsonAssetCreationQueue::BeginSession() {
+	check(IsInGameThread());
+
+	SessionDepth++;
+}
+
+void FJsonAssetCreationQueue::EndSession() {
+	check(IsInGameThread());
+	check(SessionDepth > 0);
+
+	if (--SessionDepth > 0) return;
+
+	Flush();
+
+	TArray<UObject*> RootAssets;
+	RootAssets.Reserve(Roots.Num());
+
+	for (const TWeakObjectPtr<UObject>& Root : Roots) {
+		if (Root.IsValid()) RootAssets.AddUnique(Root.Get());
+	}
+
+	SyncBrowser(RootAssets);
+
+	Roots.Reset();
+}
+
+void FJsonAssetCreationQueue::Flush() {
+	check(IsInGameThread());
+
+	TSet<UPackage*> Packages;
+
+	for (const TWeakObjectPtr<UObject>& Asset : Assets) {
+		if (!Asset.IsValid()) continue;
+
+		FAssetRegistryModule::AssetCreated(Asset.Get());
+		Packages.Add(Asset->GetOutermost());
+	}
+
+	for (UPackage* Package : Packages) {
+		Package->FullyLoad();
+	}
+
+	/* Roots hold their own pointers, the browser is still synced to them at the end */
+	Assets.Reset();
+
+	LastSyncable = INDEX_NONE;
+	LastRoot = INDEX_NONE;
+}
+
+void FJsonAssetCreationQueue::Add(UObject* Asset, const bool bSyncBrowser) {
+	if (Asset == nullptr) return;
+
+	if (SessionDepth == 0) {
+		FAssetRegistryModule::AssetCreated(Asset);
+		Asset->GetOutermost()->FullyLoad();
+
+		if (bSyncBrowser) {
+			SyncBrowser({ Asset });
+		}
+
+		return;
+	}
+
+	const int32 Index = Assets.Add(Asset);
+
+	if (bSyncBrowser) {
+		LastSyncable = Index;
+	}
+}
+
+void FJsonAssetCreationQueue::MarkRoot() {
+	if (SessionDepth == 0 || LastSyncable == LastRoot) return;
+
+	Roots.Add(Assets[LastSyncable]);
+	LastRoot = LastSyncable;
+}
+
+void FJsonAssetCreationQueue::SyncBrowser(const TArray<UObject*>& InAssets) {
+	/* There's no browser in a commandlet */
+	if (InAssets.Num() == 0 || IsRunningCommandlet()) return;
+
+	TArray<FAssetData> AssetData;
+	AssetData.Reserve(InAssets.Num());
+
+	for (const UObject* Asset : InAssets) {
+		AssetData.Add(FAssetData(Asset));
+	}
+
+	const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+	ContentBrowserModule.Get().SyncBrowserToAssets(AssetData);
+}
@@ -0,0 +1,76 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonEnumCache.h"
+
+#include "Curves/RichCurve.h"
+#include "Engine/Texture.h"
+#include "Engine/TextureRenderTarget2D.h"
+
+FJsonEnumCache& FJsonEnumCache::Get() {
+	static FJsonEnumCache Cache;
+	return Cache;
+}
+
+FJsonEnumCache::FJsonEnumCache() {
+	/* Every curve key and texture has these */
+	const UEnum* WarmEnums[] = {
+		StaticEnum<ERichCurveInterpMode>(),
+		StaticEnum<ERichCurveTangentMode>(),
+		StaticEnum<ERichCurveTangentWeightMode>(),
+		StaticEnum<ERichCurveExtrapolation>(),
+		StaticEnum<TextureAddress>(),
+		StaticEnum<TextureFilter>(),
+		StaticEnum<ETextureRenderTargetFormat>(),
+		UTexture::GetPixelFormatEnum()
+	};
+
+	for (const UEnum* Enum : WarmEnums) {
+		if (Enum != nullptr) GetTable(Enum);
+	}
+}
+
+int64 FJsonEnumCache::GetValue(const UEnum* Enum, const FString& Name) {
+	if (Enum == nullptr) return INDEX_NONE;
+
+	/* User defined enums can be edited (or imported again) at any time */
+	if (!Enum->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn)) {
+		return Enum->GetValueByNameString(Name);
+	}
+
+	const int32 SeparatorIndex = Name.Find(TEXT("::"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	const TCHAR* ShortName = SeparatorIndex == INDEX_NONE ? *Name : *Name + SeparatorIndex + 2;
+
+	/* FNAME_Find, a name that was never made can't be in the table */
+	const FName Key(ShortName, FNAME_Find);
+
+	if (!Key.IsNone()) {
+		if (const int64* Value = GetTable(Enum).Find(Key)) {
+			return *Value;
+		}
+	}
+
+	return Enum->GetValueByNameString(Name);
+}
+
+const TMap<FName, int64>& FJsonEnumCache::GetTable(const UEnum* Enum) {
+	if (const TMap<FName, int64>* Table = Tables.Find(Enum)) {
+		return *Table;
+	}
+
+	TMap<FName, int64>& Table = Tables.Add(Enum);
+
+	/* The last entry is the generated _MAX, which GetValueByNameString finds too */
+	const int32 NumNames = Enum->NumEnums();
+	Table.Reserve(NumNames);
+
+	for (int32 Index = 0; Index < NumNames; Index++) {
+		const FName Name(*Enum->GetNameStringByIndex(Index));
+
+		/* The first of two equal names wins, like it does in GetValueByNameString */
+		if (!Table.Contains(Name)) {
+			Table.Add(Name, Enum->GetValueByIndex(Index));
+		}
+	}
+
+	return Table;
+}
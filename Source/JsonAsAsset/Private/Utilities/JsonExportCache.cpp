@@ -0,0 +1,440 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonExportCache.h"
+
+#include "Utilities/JsonParsers.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Utilities/JsonStreamReader.h"
+
+static TAutoConsoleVariable<int32> CVarExportCache(
+	TEXT("JsonAsAsset.ExportCache"),
+	1,
+	TEXT("1 to keep binary copies of parsed export files in Saved/JsonAsAsset/ExportCache, 0 to always parse the JSON."),
+	ECVF_Default
+);
+
+static FAutoConsoleCommand ClearExportCacheCommand(
+	TEXT("JsonAsAsset.ClearExportCache"),
+	TEXT("Deletes the binary copies of parsed export files."),
+	FConsoleCommandDelegate::CreateStatic(&FJsonExportCache::Clear)
+);
+
+namespace {
+	constexpr uint32 CacheMagic = 0x4341414A; /* JAAC */
+	constexpr uint32 CacheVersion = 1;
+
+	/* Small files parse faster than a cache file can be opened */
+	constexpr int64 MinimumFileSize = 64 * 1024;
+
+	/* A temporary file this old isn't being written anymore */
+	const FTimespan AbandonedWriteAge = FTimespan::FromHours(1.0);
+
+	/* Object keys are case-sensitive in JSON, FString's default key funcs aren't */
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false> {
+		static const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/* Every object key is written once, values refer to it by index */
+	struct FKeyTable {
+		TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Indices;
+		TArray<FString> Keys;
+
+		int32 FindOrAdd(const FString& Key) {
+			if (const int32* Index = Indices.Find(Key)) return *Index;
+
+			const int32 Index = Keys.Add(Key);
+			Indices.Add(Key, Index);
+
+			return Index;
+		}
+	};
+
+	uint64 HashContents(const uint8* Data, int64 Size) {
+		uint64 Hash = 0;
+
+		/* CityHash64 takes 32 bit lengths, chain it over anything larger */
+		do {
+			const uint32 Chunk = static_cast<uint32>(FMath::Min<int64>(Size, MAX_uint32));
+
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Data), Chunk, Hash);
+
+			Data += Chunk;
+			Size -= Chunk;
+		} while (Size > 0);
+
+		return Hash;
+	}
+
+	/* Written aside and moved in place, so nothing ever reads half a cache file */
+	void WriteCacheFile(const FString& CachePath, const TArray<uint8>& Bytes) {
+		const FString TempPath = CachePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*CachePath, *TempPath, true, true)) {
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+		}
+	}
+
+	FString GetCachePath(const FString& FullPath) {
+		const FTCHARToUTF8 PathUTF8(*FullPath);
+		const uint64 PathHash = CityHash64(PathUTF8.Get(), PathUTF8.Length());
+
+		return FPaths::Combine(FJsonExportCache::GetCacheDirectory(), FString::Printf(TEXT("%016llx.jaacache"), PathHash));
+	}
+
+	void WriteValue(FArchive& Ar, const TSharedPtr<FJsonValue>& Value, FKeyTable& Keys) {
+		uint8 Type = static_cast<uint8>(Value.IsValid() ? Value->Type : EJson::Null);
+		Ar << Type;
+
+		if (!Value.IsValid()) return;
+
+		switch (Value->Type) {
+			case EJson::Boolean: {
+				uint8 bValue = Value->AsBool() ? 1 : 0;
+				Ar << bValue;
+				break;
+			}
+
+			case EJson::Number: {
+				double Number = Value->AsNumber();
+				Ar << Number;
+				break;
+			}
+
+			case EJson::String: {
+				FString String = Value->AsString();
+				Ar << String;
+				break;
+			}
+
+			case EJson::Array: {
+				const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+
+				int32 Num = Elements.Num();
+				Ar << Num;
+
+				for (const TSharedPtr<FJsonValue>& Element : Elements) {
+					WriteValue(Ar, Element, Keys);
+				}
+
+				break;
+			}
+
+			case EJson::Object: {
+				const TSharedPtr<FJsonObject> Object = Value->AsObject();
+
+				int32 Num = Object.IsValid() ? Object->Values.Num() : 0;
+				Ar << Num;
+
+				if (Num == 0) break;
+
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values) {
+					int32 KeyIndex = Keys.FindOrAdd(Pair.Key);
+					Ar << KeyIndex;
+
+					WriteValue(Ar, Pair.Value, Keys);
+				}
+
+				break;
+			}
+
+			default: break;
+		}
+	}
+
+	/* Every value takes at least a byte, so a count larger than what's left means the file is broken */
+	bool ReadCount(FArchive& Ar, int32& OutNum) {
+		Ar << OutNum;
+
+		return !Ar.IsError() && OutNum >= 0 && OutNum <= Ar.TotalSize() - Ar.Tell();
+	}
+
+	TSharedPtr<FJsonValue> ReadValue(FArchive& Ar, const TArray<FString>& Keys, const int32 Depth) {
+		if (Depth > JsonParsers::MaxDepth) {
+			Ar.SetError();
+			return nullptr;
+		}
+
+		uint8 Type = 0;
+		Ar << Type;
+
+		switch (static_cast<EJson>(Type)) {
+			case EJson::Null: return MakeShared<FJsonValueNull>();
+
+			case EJson::Boolean: {
+				uint8 bValue = 0;
+				Ar << bValue;
+
+				return MakeShared<FJsonValueBoolean>(bValue != 0);
+			}
+
+			case EJson::Number: {
+				double Number = 0.0;
+				Ar << Number;
+
+				return MakeShared<FJsonValueNumber>(Number);
+			}
+
+			case EJson::String: {
+				FString String;
+				Ar << String;
+
+				return MakeShared<FJsonValueString>(MoveTemp(String));
+			}
+
+			case EJson::Array: {
+				int32 Num = 0;
+				if (!ReadCount(Ar, Num)) break;
+
+				TArray<TSharedPtr<FJsonValue>> Elements;
+				Elements.Reserve(Num);
+
+				for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++) {
+					Elements.Add(ReadValue(Ar, Keys, Depth + 1));
+				}
+
+				return MakeShared<FJsonValueArray>(Elements);
+			}
+
+			case EJson::Object: {
+				int32 Num = 0;
+				if (!ReadCount(Ar, Num)) break;
+
+				TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+				Object->Values.Reserve(Num);
+
+				for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++) {
+					int32 KeyIndex = INDEX_NONE;
+					Ar << KeyIndex;
+
+					if (!Keys.IsValidIndex(KeyIndex)) {
+						Ar.SetError();
+						break;
+					}
+
+					Object->Values.Add(Keys[KeyIndex], ReadValue(Ar, Keys, Depth + 1));
+				}
+
+				return MakeShared<FJsonValueObject>(Object);
+			}
+
+			default: break;
+		}
+
+		Ar.SetError();
+		return nullptr;
+	}
+}
+
+bool FJsonExportCache::IsEnabled() {
+	return CVarExportCache.GetValueOnAnyThread() != 0;
+}
+
+FJsonExportCache::FStamp FJsonExportCache::GetStamp(const FString& FilePath) {
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+
+	FStamp Stamp;
+
+	if (StatData.bIsValid && !StatData.bIsDirectory) {
+		Stamp.Size = StatData.FileSize;
+		Stamp.Ticks = StatData.ModificationTime.GetTicks();
+	}
+
+	return Stamp;
+}
+
+bool FJsonExportCache::Load(const FString& FilePath, TArray<TSharedPtr<FJsonValue>>& OutElements) {
+	if (!IsEnabled()) return false;
+
+	const FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+
+	const FStamp Stamp = GetStamp(FullPath);
+	if (Stamp.Size < MinimumFileSize) return false;
+
+	const FString CachePath = GetCachePath(FullPath);
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *CachePath, FILEREAD_Silent)) return false;
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FString SourcePath;
+	int64 Size = 0;
+	int64 Ticks = 0;
+	uint64 Hash = 0;
+
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != CacheMagic || Version != CacheVersion) return false;
+
+	Reader << SourcePath << Size;
+
+	const int64 TicksOffset = Reader.Tell();
+	Reader << Ticks << Hash;
+
+	if (Reader.IsError() || SourcePath != FullPath || Size != Stamp.Size) return false;
+
+	/* Touched but not necessarily changed (a checkout, a copy), the hash decides */
+	const bool bRestamp = Ticks != Stamp.Ticks;
+
+	if (bRestamp) {
+		FJsonFileView File;
+		if (!File.Open(FullPath) || HashContents(File.GetData(), File.Num()) != Hash) return false;
+	}
+
+	TArray<FString> Keys;
+	int32 NumKeys = 0;
+	if (!ReadCount(Reader, NumKeys)) return false;
+
+	Keys.SetNum(NumKeys);
+
+	for (FString& Key : Keys) {
+		Reader << Key;
+	}
+
+	int32 NumElements = 0;
+	if (!ReadCount(Reader, NumElements)) return false;
+
+	TArray<TSharedPtr<FJsonValue>> Elements;
+	Elements.Reserve(NumElements);
+
+	for (int32 Index = 0; Index < NumElements && !Reader.IsError(); Index++) {
+		Elements.Add(ReadValue(Reader, Keys, 1));
+	}
+
+	if (Reader.IsError()) {
+		UE_LOG(LogJson, Warning, TEXT("Ignoring broken export cache %s"), *CachePath);
+		return false;
+	}
+
+	if (bRestamp) {
+		FMemory::Memcpy(Bytes.GetData() + TicksOffset, &Stamp.Ticks, sizeof(Stamp.Ticks));
+		WriteCacheFile(CachePath, Bytes);
+	}
+
+	OutElements = MoveTemp(Elements);
+	return true;
+}
+
+void FJsonExportCache::Save(const FString& FilePath, const FStamp& Stamp, const uint8* Data, const int64 Size, const TArray<TSharedPtr<FJsonValue>>& Elements) {
+	if (!IsEnabled()) return;
+
+	if (Stamp.Size < MinimumFileSize) return;
+
+	const FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+
+	/* Values go first so the key table is complete when the header is written */
+	FKeyTable Keys;
+	TArray<uint8> Body;
+
+	{
+		FMemoryWriter Writer(Body);
+
+		int32 NumElements = Elements.Num();
+		Writer << NumElements;
+
+		for (const TSharedPtr<FJsonValue>& Element : Elements) {
+			WriteValue(Writer, Element, Keys);
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = CacheMagic;
+	uint32 Version = CacheVersion;
+	FString SourcePath = FullPath;
+	int64 FileSize = Stamp.Size;
+	int64 Ticks = Stamp.Ticks;
+	uint64 Hash = HashContents(Data, Size);
+
+	Writer << Magic << Version << SourcePath << FileSize << Ticks << Hash;
+
+	int32 NumKeys = Keys.Keys.Num();
+	Writer << NumKeys;
+
+	for (FString& Key : Keys.Keys) {
+		Writer << Key;
+	}
+
+	Writer.Serialize(Body.GetData(), Body.Num());
+
+	WriteCacheFile(GetCachePath(FullPath), Bytes);
+}
+
+void FJsonExportCache::Forget(const FString& FilePath) {
+	IFileManager::Get().Delete(*GetCachePath(FPaths::ConvertRelativePathToFull(FilePath)), false, false, true);
+}
+
+void FJsonExportCache::Prune() {
+	const FString Directory = GetCacheDirectory();
+	if (!IFileManager::Get().DirectoryExists(*Directory)) return;
+
+	TArray<FString> ToDelete;
+	int32 NumFiles = 0;
+
+	IFileManager::Get().IterateDirectoryStat(*Directory, [&ToDelete, &NumFiles](const TCHAR* Path, const FFileStatData& StatData) {
+		if (StatData.bIsDirectory) return true;
+
+		const FString Extension = FPaths::GetExtension(Path);
+
+		if (Extension == TEXT("tmp")) {
+			if (FDateTime::UtcNow() - StatData.ModificationTime > AbandonedWriteAge) {
+				ToDelete.Add(Path);
+			}
+
+			return true;
+		}
+
+		if (Extension != TEXT("jaacache")) return true;
+
+		NumFiles++;
+
+		/* The header is enough to tell which export file a cache file was made from */
+		const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(Path, FILEREAD_Silent));
+		if (!Reader.IsValid()) return true;
+
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		FString SourcePath;
+
+		*Reader << Magic << Version;
+
+		if (!Reader->IsError() && Magic == CacheMagic && Version == CacheVersion) {
+			*Reader << SourcePath;
+		}
+
+		if (Reader->IsError() || Magic != CacheMagic || Version != CacheVersion || !FPaths::FileExists(SourcePath)) {
+			ToDelete.Add(Path);
+		}
+
+		return true;
+	});
+
+	for (const FString& Path : ToDelete) {
+		IFileManager::Get().Delete(*Path, false, false, true);
+	}
+
+	if (ToDelete.Num() > 0) {
+		UE_LOG(LogJson, Log, TEXT("Deleted %d of %d export cache files"), ToDelete.Num(), NumFiles);
+	}
+}
+
+void FJsonExportCache::Clear() {
+	IFileManager::Get().DeleteDirectory(*GetCacheDirectory(), false, true);
+}
+
+FString FJsonExportCache::GetCacheDirectory() {
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonAsAsset"), TEXT("ExportCache"));
+}
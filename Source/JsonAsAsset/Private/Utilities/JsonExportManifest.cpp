@@ -0,0 +1,466 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonExportManifest.h"
+
+#include "Utilities/JsonExportCache.h"
+#include "Utilities/JsonParsers.h"
+#include "Utilities/JsonStreamReader.h"
+
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "DirectoryWatcherModule.h"
+#include "HAL/FileManager.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Settings/JsonAsAssetSettings.h"
+
+FJsonExportManifest& FJsonExportManifest::Get() {
+	static FJsonExportManifest Manifest;
+	return Manifest;
+}
+
+void FJsonExportManifest::Initialize() {
+	Rebuild();
+}
+
+void FJsonExportManifest::Shutdown() {
+	Unwatch();
+
+	Generation.Increment();
+
+	if (BuildTask.IsValid()) {
+		BuildTask.Wait();
+	}
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+
+		PendingScans.Empty();
+		DeferredFiles.Empty();
+		bBuilding = false;
+	}
+
+	if (ScanTask.IsValid()) {
+		ScanTask.Wait();
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+
+	Entries.Empty();
+	bReady = false;
+}
+
+void FJsonExportManifest::Rebuild() {
+	check(IsInGameThread());
+
+	const FString Directory = GetExportDirectory();
+	const int32 BuildGeneration = Generation.Increment();
+
+	/* Sees the new generation and stops at the next file */
+	if (BuildTask.IsValid()) {
+		BuildTask.Wait();
+	}
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+
+		Entries.Empty();
+		DeferredFiles.Empty();
+		bDeferredRescan = false;
+		PendingScans.Empty();
+		Root = Directory;
+		bReady = false;
+		bBuilding = false;
+	}
+
+	Watch(Directory);
+
+	if (Directory.IsEmpty() || !IFileManager::Get().DirectoryExists(*Directory)) return;
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+		bBuilding = true;
+	}
+
+	BuildTask = Async(EAsyncExecution::ThreadPool, [this, Directory, BuildGeneration]() {
+		Build(Directory, BuildGeneration);
+	});
+}
+
+void FJsonExportManifest::Build(const FString Directory, const int32 BuildGeneration) {
+	const double StartTime = FPlatformTime::Seconds();
+
+	TMap<FString, FJsonExportManifestEntry> Found;
+
+	IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [this, &Directory, &Found, BuildGeneration](const TCHAR* Path, const FFileStatData& StatData) {
+		if (StatData.bIsDirectory || !FPaths::GetExtension(Path).Equals(TEXT("json"), ESearchCase::IgnoreCase)) {
+			return Generation.GetValue() == BuildGeneration;
+		}
+
+		FJsonExportManifestEntry Entry;
+		Entry.FilePath = FPaths::ConvertRelativePathToFull(Path);
+		Entry.Size = StatData.FileSize;
+		Entry.Timestamp = StatData.ModificationTime;
+
+		FPaths::NormalizeFilename(Entry.FilePath);
+
+		Found.Add(MakeRelativePath(Directory, Entry.FilePath), MoveTemp(Entry));
+
+		return Generation.GetValue() == BuildGeneration;
+	});
+
+	/* Paths are all a lookup needs, make them available before reading any file */
+	TArray<FPendingScan> ToScan;
+	ToScan.Reserve(Found.Num());
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+		if (Generation.GetValue() != BuildGeneration) return;
+
+		for (const TPair<FString, FJsonExportManifestEntry>& Pair : Found) {
+			ToScan.Add({ Pair.Key, Pair.Value.FilePath, Pair.Value.Timestamp });
+		}
+
+		Entries = MoveTemp(Found);
+		bReady = true;
+		bBuilding = false;
+	}
+
+	/* Whatever the watcher heard while the directory was listed may be missing from it */
+	AsyncTask(ENamedThreads::GameThread, [this, BuildGeneration]() {
+		ApplyDeferredChanges(BuildGeneration);
+	});
+
+	UE_LOG(LogJson, Log, TEXT("Indexed %d export files in %.2f s"), ToScan.Num(), FPlatformTime::Seconds() - StartTime);
+
+	/* Exports deleted or renamed since the last build leave cache files nothing will read again */
+	FJsonExportCache::Prune();
+
+	for (const FPendingScan& File : ToScan) {
+		if (Generation.GetValue() != BuildGeneration) return;
+
+		TArray<FName> Types;
+		ScanTypes(File.FilePath, Types);
+
+		SetTypes(File.RelativePath, File.Timestamp, MoveTemp(Types));
+	}
+}
+
+void FJsonExportManifest::QueueScan(FPendingScan&& Scan) {
+	FWriteScopeLock WriteLock(Lock);
+
+	PendingScans.Add(MoveTemp(Scan));
+
+	if (bScanning) return;
+
+	bScanning = true;
+
+	ScanTask = Async(EAsyncExecution::ThreadPool, [this]() {
+		ScanPending();
+	});
+}
+
+void FJsonExportManifest::ScanPending() {
+	while (true) {
+		FPendingScan Scan;
+
+		{
+			FWriteScopeLock WriteLock(Lock);
+
+			if (PendingScans.Num() == 0) {
+				bScanning = false;
+				return;
+			}
+
+			Scan = PendingScans.Pop();
+		}
+
+		TArray<FName> Types;
+		ScanTypes(Scan.FilePath, Types);
+
+		SetTypes(Scan.RelativePath, Scan.Timestamp, MoveTemp(Types));
+	}
+}
+
+void FJsonExportManifest::SetTypes(const FString& RelativePath, const FDateTime& Timestamp, TArray<FName>&& Types) {
+	FWriteScopeLock WriteLock(Lock);
+
+	/* The watcher may have replaced or removed the entry meanwhile */
+	FJsonExportManifestEntry* Entry = Entries.Find(RelativePath);
+
+	if (Entry != nullptr && Entry->Timestamp == Timestamp) {
+		Entry->Types = MoveTemp(Types);
+		Entry->bScanned = true;
+	}
+}
+
+bool FJsonExportManifest::IsBuilding() const {
+	return !bReady && BuildTask.IsValid() && !BuildTask.IsReady();
+}
+
+void FJsonExportManifest::Refresh() {
+	check(IsInGameThread());
+
+	if (Root != GetExportDirectory()) {
+		Rebuild();
+	}
+}
+
+bool FJsonExportManifest::WaitUntilReady() const {
+	while (!bReady) {
+		if (!BuildTask.IsValid() || BuildTask.IsReady()) return bReady;
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	return true;
+}
+
+bool FJsonExportManifest::FindFile(const FString& RelativePath, FString& OutFilePath) {
+	const FString Directory = GetExportDirectory();
+
+	{
+		FReadScopeLock ReadLock(Lock);
+
+		if (bReady && Root == Directory) {
+			const FJsonExportManifestEntry* Entry = Entries.Find(RelativePath);
+			if (Entry == nullptr) return false;
+
+			OutFilePath = Entry->FilePath;
+			return true;
+		}
+	}
+
+	/* The export directory was changed in the settings */
+	if (IsInGameThread() && Root != Directory) {
+		Rebuild();
+	}
+
+	OutFilePath = FPaths::Combine(Directory, RelativePath + TEXT(".json"));
+	return FPaths::FileExists(OutFilePath);
+}
+
+bool FJsonExportManifest::FindEntry(const FString& RelativePath, FJsonExportManifestEntry& OutEntry) const {
+	FReadScopeLock ReadLock(Lock);
+
+	const FJsonExportManifestEntry* Entry = Entries.Find(RelativePath);
+	if (Entry == nullptr) return false;
+
+	OutEntry = *Entry;
+	return true;
+}
+
+TArray<FString> FJsonExportManifest::FindByType(const FName Type) const {
+	TArray<FString> RelativePaths;
+
+	FReadScopeLock ReadLock(Lock);
+
+	for (const TPair<FString, FJsonExportManifestEntry>& Pair : Entries) {
+		if (Pair.Value.Types.Contains(Type)) {
+			RelativePaths.Add(Pair.Key);
+		}
+	}
+
+	return RelativePaths;
+}
+
+void FJsonExportManifest::OnDirectoryChanged(const TArray<FFileChangeData>& Changes) {
+	{
+		FWriteScopeLock WriteLock(Lock);
+
+		/* The build would replace anything done to the entries now */
+		if (bBuilding) {
+			for (const FFileChangeData& Change : Changes) {
+				if (Change.Action == FFileChangeData::FCA_RescanRequired) {
+					bDeferredRescan = true;
+				} else {
+					DeferredFiles.Add(Change.Filename);
+				}
+			}
+
+			return;
+		}
+	}
+
+	for (const FFileChangeData& Change : Changes) {
+		if (Change.Action == FFileChangeData::FCA_RescanRequired) {
+			Rebuild();
+			return;
+		}
+
+		if (!FPaths::GetExtension(Change.Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase)) continue;
+
+		FString FilePath = FPaths::ConvertRelativePathToFull(Change.Filename);
+		FPaths::NormalizeFilename(FilePath);
+
+		const FString RelativePath = MakeRelativePath(Root, FilePath);
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+
+		if (Change.Action == FFileChangeData::FCA_Removed || !StatData.bIsValid) {
+			FJsonExportCache::Forget(FilePath);
+
+			FWriteScopeLock WriteLock(Lock);
+			Entries.Remove(RelativePath);
+
+			continue;
+		}
+
+		FJsonExportManifestEntry Entry;
+		Entry.FilePath = FilePath;
+		Entry.Size = StatData.FileSize;
+		Entry.Timestamp = StatData.ModificationTime;
+
+		{
+			FWriteScopeLock WriteLock(Lock);
+			Entries.Add(RelativePath, MoveTemp(Entry));
+		}
+
+		/* Reading the file would hold up the game thread, FindByType skips it until it's scanned */
+		QueueScan({ RelativePath, FilePath, StatData.ModificationTime });
+	}
+}
+
+void FJsonExportManifest::ApplyDeferredChanges(const int32 BuildGeneration) {
+	TArray<FFileChangeData> Changes;
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+		if (Generation.GetValue() != BuildGeneration) return;
+
+		if (bDeferredRescan) {
+			Changes.Emplace(FString(), FFileChangeData::FCA_RescanRequired);
+		}
+
+		/* Changes are applied from what's on disk now, what happened to a file doesn't matter */
+		for (const FString& File : DeferredFiles) {
+			Changes.Emplace(File, FFileChangeData::FCA_Modified);
+		}
+
+		DeferredFiles.Reset();
+		bDeferredRescan = false;
+	}
+
+	if (Changes.Num() > 0) {
+		OnDirectoryChanged(Changes);
+	}
+}
+
+void FJsonExportManifest::Watch(const FString& Directory) {
+	if (Directory == WatchedDirectory && WatcherHandle.IsValid()) return;
+
+	Unwatch();
+
+	if (Directory.IsEmpty() || !IFileManager::Get().DirectoryExists(*Directory)) return;
+
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>("DirectoryWatcher").Get();
+	if (DirectoryWatcher == nullptr) return;
+
+	DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+		Directory,
+		IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FJsonExportManifest::OnDirectoryChanged),
+		WatcherHandle
+	);
+
+	WatchedDirectory = Directory;
+}
+
+void FJsonExportManifest::Unwatch() {
+	if (!WatcherHandle.IsValid()) return;
+
+	/* Already gone when the editor is shutting down */
+	if (FDirectoryWatcherModule* Module = FModuleManager::GetModulePtr<FDirectoryWatcherModule>("DirectoryWatcher")) {
+		if (IDirectoryWatcher* DirectoryWatcher = Module->Get()) {
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedDirectory, WatcherHandle);
+		}
+	}
+
+	WatcherHandle.Reset();
+	WatchedDirectory.Empty();
+}
+
+FString FJsonExportManifest::MakeRelativePath(const FString& Directory, const FString& FilePath) {
+	FString RelativePath = FilePath;
+	FPaths::MakePathRelativeTo(RelativePath, *(Directory + TEXT("/")));
+
+	return FPaths::GetBaseFilename(RelativePath, false);
+}
+
+FString FJsonExportManifest::GetExportDirectory() {
+	FString Directory = GetDefault<UJsonAsAssetSettings>()->ExportDirectory.Path;
+	if (Directory.IsEmpty()) return Directory;
+
+	Directory = FPaths::ConvertRelativePathToFull(Directory);
+	FPaths::NormalizeDirectoryName(Directory);
+
+	return Directory;
+}
+
+void FJsonExportManifest::ScanTypes(const FString& FilePath, TArray<FName>& OutTypes) {
+	FJsonFileView File;
+	if (!File.Open(FilePath)) return;
+
+	const uint8* Current = File.GetData();
+	const uint8* End = Current + File.Num();
+
+	/*
+	 * Only nesting and strings are tracked, nothing is parsed: a string at depth 2 followed by a
+	 * colon is a key of an export, and the string after a "Type" key is what we're after.
+	 */
+	int32 Depth = 0;
+
+	auto SkipWhitespace = [&End](const uint8* Position) {
+		while (Position < End && JsonParsers::IsWhitespace(*Position)) Position++;
+		return Position;
+	};
+
+	/* Returns the closing quote of the string opening at Start, and whether it had escapes */
+	auto FindStringEnd = [&End](const uint8* Start, bool& bOutEscaped) {
+		const uint8* Position = Start + 1;
+		bOutEscaped = false;
+
+		while (Position < End && *Position != '"') {
+			if (*Position == '\\') {
+				bOutEscaped = true;
+				Position++;
+			}
+
+			Position++;
+		}
+
+		return Position;
+	};
+
+	while (Current < End) {
+		const uint8 Character = *Current;
+
+		if (Character == '{' || Character == '[') {
+			Depth++;
+		} else if (Character == '}' || Character == ']') {
+			Depth--;
+		} else if (Character == '"') {
+			bool bEscaped;
+			const uint8* KeyEnd = FindStringEnd(Current, bEscaped);
+			const bool bTypeKey = Depth == 2 && KeyEnd - Current == 5 && FMemory::Memcmp(Current + 1, "Type", 4) == 0;
+
+			Current = KeyEnd;
+
+			const uint8* Colon = bTypeKey ? SkipWhitespace(KeyEnd + 1) : End;
+			const uint8* Value = Colon < End && *Colon == ':' ? SkipWhitespace(Colon + 1) : End;
+
+			if (Value < End && *Value == '"') {
+				const uint8* ValueEnd = FindStringEnd(Value, bEscaped);
+
+				/* Class names never need escaping */
+				if (ValueEnd < End && !bEscaped) {
+					const FUTF8ToTCHAR Type(reinterpret_cast<const ANSICHAR*>(Value + 1), static_cast<int32>(ValueEnd - Value - 1));
+					OutTypes.AddUnique(FName(Type.Length(), Type.Get()));
+				}
+
+				Current = ValueEnd;
+			}
+		}
+
+		Current++;
+	}
+}
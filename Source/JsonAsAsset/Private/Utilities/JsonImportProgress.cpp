@@ -0,0 +1,215 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonImportProgress.h"
+
+#include "Utilities/EngineUtilities.h"
+
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/MessageLog.h"
+#include "Misc/Paths.h"
+#include "Styling/SlateIconFinder.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+static TAutoConsoleVariable<int32> CVarMaxImportToasts(
+	TEXT("JsonAsAsset.MaxImportToasts"),
+	10,
+	TEXT("Assets of an import session that still get a notification of their own, the rest only show in the progress notification."),
+	ECVF_Default
+);
+
+namespace {
+	/* Slate lays out the notification again on every change, a few times a second is enough */
+	constexpr double UpdateInterval = 0.25;
+
+	bool IsFailure(const EJsonImportEvent Event) {
+		return Event == EJsonImportEvent::ImportFailed || Event == EJsonImportEvent::DownloadFailed;
+	}
+}
+
+FJsonImportProgress& FJsonImportProgress::Get() {
+	static FJsonImportProgress Progress;
+	return Progress;
+}
+
+void FJsonImportProgress::BeginSession(const int32 InNumFiles) {
+	if (SessionDepth++ > 0) return;
+
+	NumFiles = InNumFiles;
+	NumFilesDone = 0;
+	NumAssets = 0;
+	NumFailed = 0;
+
+	StartTime = FPlatformTime::Seconds();
+	LastUpdateTime = 0.0;
+
+	CountsByType.Reset();
+	CurrentFile.Reset();
+	Messages.Reset();
+
+	/* Nothing to show it on when running headless */
+	if (IsRunningCommandlet()) return;
+
+	FNotificationInfo Info(FText::FromString("Importing JSON files..."));
+	Info.bFireAndForget = false;
+	Info.bUseLargeFont = true;
+	Info.WidthOverride = FOptionalSize(350.0f);
+
+	Notification = FSlateNotificationManager::Get().AddNotification(Info);
+
+	if (Notification.IsValid()) {
+		Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+}
+
+void FJsonImportProgress::EndSession() {
+	check(SessionDepth > 0);
+
+	if (--SessionDepth > 0) return;
+
+	/* Files in the order their first line was recorded, references imported along the way go on the page of the file that needed them */
+	TArray<FString> Files;
+	TMap<FString, TArray<TSharedRef<FTokenizedMessage>>> MessagesByFile;
+
+	for (const TPair<FString, TSharedRef<FTokenizedMessage>>& Message : Messages) {
+		TArray<TSharedRef<FTokenizedMessage>>* FileMessages = MessagesByFile.Find(Message.Key);
+
+		if (FileMessages == nullptr) {
+			Files.Add(Message.Key);
+			FileMessages = &MessagesByFile.Add(Message.Key);
+		}
+
+		FileMessages->Add(Message.Value);
+	}
+
+	FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
+
+	for (const FString& File : Files) {
+		MessageLogger.NewPage(FText::FromString(File.IsEmpty() ? TEXT("JSON Import") : FPaths::GetCleanFilename(File)));
+		MessageLogger.AddMessages(MessagesByFile[File]);
+	}
+
+	MessageLogger.Info(GetSummary());
+
+	Messages.Reset();
+
+	if (Notification.IsValid()) {
+		UpdateNotification(true);
+
+		Notification->SetCompletionState(NumFailed == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		Notification->SetExpireDuration(5.0f);
+		Notification->ExpireAndFadeout();
+
+		Notification.Reset();
+	}
+}
+
+void FJsonImportProgress::Record(const EJsonImportEvent Event, const FString& Type, const FString& Name) {
+	if (SessionDepth == 0) {
+		ShowToast(Event, Type, Name);
+		FMessageLog(FName("JsonAsAsset")).AddMessage(MakeMessage(Event, Type, Name));
+
+		return;
+	}
+
+	NumAssets++;
+	if (IsFailure(Event)) NumFailed++;
+
+	CountsByType.FindOrAdd(Type)++;
+	Messages.Emplace(CurrentFile, MakeMessage(Event, Type, Name));
+
+	if (NumAssets <= CVarMaxImportToasts.GetValueOnGameThread()) {
+		ShowToast(Event, Type, Name);
+	}
+
+	UpdateNotification(false);
+}
+
+void FJsonImportProgress::BeginFile(const FString& File) {
+	if (SessionDepth == 0) return;
+
+	CurrentFile = File;
+}
+
+void FJsonImportProgress::FinishFile() {
+	if (SessionDepth == 0) return;
+
+	CurrentFile.Reset();
+	NumFilesDone++;
+	UpdateNotification(false);
+}
+
+void FJsonImportProgress::ShowToast(const EJsonImportEvent Event, const FString& Type, const FString& Name) {
+	if (IsRunningCommandlet()) return;
+
+	const FSlateBrush* IconBrush = FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail"));
+
+	switch (Event) {
+		case EJsonImportEvent::Imported:
+			AppendNotification(FText::FromString("Imported type: " + Type), FText::FromString(Name), 2.0f, IconBrush, SNotificationItem::CS_Success, false, 350.0f);
+			break;
+		case EJsonImportEvent::ImportFailed:
+			AppendNotification(FText::FromString("Import Failed: " + Type), FText::FromString(Name), 2.0f, IconBrush, SNotificationItem::CS_Fail, false, 350.0f);
+			break;
+		case EJsonImportEvent::Downloaded:
+			AppendNotification(FText::FromString("Locally Downloaded: " + Type), FText::FromString(Name), 2.0f, IconBrush, SNotificationItem::CS_Success, false, 310.0f);
+			break;
+		case EJsonImportEvent::DownloadFailed:
+			AppendNotification(FText::FromString("Download Failed: " + Type), FText::FromString(Name), 5.0f, IconBrush, SNotificationItem::CS_Fail, false, 310.0f);
+			break;
+	}
+}
+
+TSharedRef<FTokenizedMessage> FJsonImportProgress::MakeMessage(const EJsonImportEvent Event, const FString& Type, const FString& Name) {
+	switch (Event) {
+		case EJsonImportEvent::ImportFailed:
+			return FTokenizedMessage::Create(EMessageSeverity::Error, FText::FromString("Failed to import asset: " + Name + " (" + Type + ")"));
+		case EJsonImportEvent::Downloaded:
+			return FTokenizedMessage::Create(EMessageSeverity::Info, FText::FromString("Downloaded asset: " + Name + " (" + Type + ")"));
+		case EJsonImportEvent::DownloadFailed:
+			return FTokenizedMessage::Create(EMessageSeverity::Error, FText::FromString("Failed to download asset: " + Name + " (" + Type + ")"));
+		default:
+			return FTokenizedMessage::Create(EMessageSeverity::Info, FText::FromString("Imported Asset: " + Name + " (" + Type + ")"));
+	}
+}
+
+void FJsonImportProgress::UpdateNotification(const bool bForce) {
+	if (!Notification.IsValid()) return;
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bForce && Now - LastUpdateTime < UpdateInterval) return;
+
+	LastUpdateTime = Now;
+
+	const FText Summary = GetSummary();
+
+#if ENGINE_MAJOR_VERSION >= 5
+	Notification->SetText(FText::FromString(FString::Printf(TEXT("Importing JSON files (%d/%d)"), NumFilesDone, NumFiles)));
+	Notification->SetSubText(Summary);
+#else
+	Notification->SetText(FText::FromString(FString::Printf(TEXT("Importing JSON files (%d/%d)\n"), NumFilesDone, NumFiles) + Summary.ToString()));
+#endif
+}
+
+FText FJsonImportProgress::GetSummary() const {
+	const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.001);
+
+	FString Summary = FString::Printf(TEXT("%d assets, %d failed, %.1f assets/s"), NumAssets, NumFailed, NumAssets / Seconds);
+
+	if (NumFilesDone > 0 && NumFilesDone < NumFiles) {
+		const double SecondsLeft = Seconds / NumFilesDone * (NumFiles - NumFilesDone);
+		Summary += FString::Printf(TEXT(", %s left"), *FTimespan::FromSeconds(FMath::CeilToInt(SecondsLeft)).ToString(TEXT("%m:%s")));
+	}
+
+	/* Most imported types first */
+	TArray<TPair<FString, int32>> Types = CountsByType.Array();
+	Types.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) {
+		return A.Value > B.Value;
+	});
+
+	for (const TPair<FString, int32>& Type : Types) {
+		Summary += FString::Printf(TEXT("\n%s: %d"), *Type.Key, Type.Value);
+	}
+
+	return FText::FromString(Summary);
+}
@@ -0,0 +1,143 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonImportReferences.h"
+
+#include "Editor.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonGlobals.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+#include "Utilities/JsonAssetCreationQueue.h"
+#include "Utilities/JsonPackageSaveQueue.h"
+
+static TAutoConsoleVariable<int32> CVarGCBetweenWaves(
+	TEXT("JsonAsAsset.GCBetweenWaves"),
+	0,
+	TEXT("Collect garbage between dependency waves of an import once this many files were imported since the last collection, saved assets that aren't open in an editor are unloaded with it. 0 to leave it to the editor."),
+	ECVF_Default
+);
+
+FJsonImportReferences& FJsonImportReferences::Get() {
+	static FJsonImportReferences References;
+	return References;
+}
+
+void FJsonImportReferences::BeginSession() {
+	check(IsInGameThread());
+
+	if (SessionDepth++ == 0) {
+		NumFilesSinceCollection = 0;
+	}
+}
+
+void FJsonImportReferences::EndSession() {
+	check(IsInGameThread());
+	check(SessionDepth > 0);
+
+	if (--SessionDepth > 0) return;
+
+	Objects.Empty();
+	Packages.Empty();
+}
+
+void FJsonImportReferences::Keep(UObject* Object) {
+	if (Object == nullptr) return;
+
+	if (SessionDepth == 0) {
+		Object->AddToRoot();
+		return;
+	}
+
+	Objects.Add(Object);
+
+	if (Object->IsAsset()) {
+		Packages.Add(Object->GetOutermost());
+	}
+}
+
+void FJsonImportReferences::FinishWave(const int32 NumFiles) {
+	if (SessionDepth == 0) return;
+
+	/* Later waves load these from disk instead of needing them in memory */
+	FJsonPackageSaveQueue& SaveQueue = FJsonPackageSaveQueue::Get();
+
+	if (SaveQueue.IsInSession()) {
+		SaveQueue.Flush();
+	}
+
+	/* Later waves reference these assets by path, they don't need them held */
+	Objects.Reset();
+
+	NumFilesSinceCollection += NumFiles;
+
+	const int32 CollectionInterval = CVarGCBetweenWaves.GetValueOnGameThread();
+	if (CollectionInterval <= 0 || NumFilesSinceCollection < CollectionInterval) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	/* The registry has to hear about assets before they can be unloaded */
+	FJsonAssetCreationQueue& CreationQueue = FJsonAssetCreationQueue::Get();
+
+	if (CreationQueue.IsInSession()) {
+		CreationQueue.Flush();
+	}
+
+	const TArray<TWeakObjectPtr<UObject>> Released = ReleaseSavedPackages();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	/* Held by the transaction buffer, the selection or another asset, they're assets like before */
+	for (const TWeakObjectPtr<UObject>& Object : Released) {
+		if (Object.IsValid()) Object->SetFlags(RF_Standalone);
+	}
+
+	UE_LOG(LogJson, Log, TEXT("Collected garbage after %d files in %.2f s"), NumFilesSinceCollection, FPlatformTime::Seconds() - StartTime);
+
+	NumFilesSinceCollection = 0;
+}
+
+TArray<TWeakObjectPtr<UObject>> FJsonImportReferences::ReleaseSavedPackages() {
+	TArray<TWeakObjectPtr<UObject>> Released;
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor != nullptr ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+
+	for (const TWeakObjectPtr<UPackage>& WeakPackage : Packages) {
+		UPackage* Package = WeakPackage.Get();
+
+		/* Unsaved changes would be lost, they stay loaded */
+		if (Package == nullptr || Package->IsDirty()) continue;
+
+		bool bEdited = false;
+
+		if (AssetEditorSubsystem != nullptr) {
+			ForEachObjectWithPackage(Package, [AssetEditorSubsystem, &bEdited](UObject* Object) {
+				bEdited = Object->IsAsset() && AssetEditorSubsystem->FindEditorForAsset(Object, false) != nullptr;
+				return !bEdited;
+			}, false);
+		}
+
+		if (bEdited) continue;
+
+		ForEachObjectWithPackage(Package, [&Released](UObject* Object) {
+			if (Object->HasAnyFlags(RF_Standalone)) {
+				Object->ClearFlags(RF_Standalone);
+				Released.Add(Object);
+			}
+
+			return true;
+		});
+	}
+
+	Packages.Reset();
+
+	return Released;
+}
+
+void FJsonImportReferences::AddReferencedObjects(FReferenceCollector& Collector) {
+	Collector.AddReferencedObjects(Objects);
+}
+
+FString FJsonImportReferences::GetReferencerName() const {
+	return TEXT("FJsonImportReferences");
+}
@@ -0,0 +1,169 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonPackageSaveQueue.h"
+
+#include "HAL/IConsoleManager.h"
+#include "JsonGlobals.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+static TAutoConsoleVariable<int32> CVarConcurrentSave(
+	TEXT("JsonAsAsset.ConcurrentSave"),
+	0,
+	TEXT("1 to save the packages of an import session concurrently (UE5, experimental in the engine), 0 to save them one after another."),
+	ECVF_Default
+);
+
+FJsonPackageSaveQueue& FJsonPackageSaveQueue::Get() {
+	static FJsonPackageSaveQueue Queue;
+	return Queue;
+}
+
+void FJsonPackageSaveQueue::BeginSession() {
+	check(IsInGameThread());
+
+	if (SessionDepth++ == 0) {
+		SessionReport = FJsonPackageSaveReport();
+	}
+}
+
+FJsonPackageSaveReport FJsonPackageSaveQueue::EndSession() {
+	check(IsInGameThread());
+	check(SessionDepth > 0);
+
+	if (--SessionDepth > 0) return FJsonPackageSaveReport();
+
+	Flush();
+
+	return MoveTemp(SessionReport);
+}
+
+FJsonPackageSaveReport FJsonPackageSaveQueue::Flush() {
+	check(IsInGameThread());
+
+	FJsonPackageSaveReport Report;
+
+	TArray<UPackage*> Packages;
+	Packages.Reserve(Queued.Num());
+
+	/* Packages that were garbage collected meanwhile have nothing left to save */
+	for (const TWeakObjectPtr<UPackage>& Package : Queued) {
+		if (Package.IsValid()) Packages.Add(Package.Get());
+	}
+
+	Queued.Reset();
+	QueuedNames.Reset();
+
+	if (Packages.Num() == 0) return Report;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+#if ENGINE_MAJOR_VERSION >= 5
+	if (CVarConcurrentSave.GetValueOnGameThread() != 0) {
+		TArray<FPackageSaveInfo> SaveInfos;
+		SaveInfos.Reserve(Packages.Num());
+
+		for (UPackage* Package : Packages) {
+			FPackageSaveInfo& SaveInfo = SaveInfos.AddDefaulted_GetRef();
+			SaveInfo.Package = Package;
+			SaveInfo.Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		}
+
+		FSavePackageArgs SaveArgs; {
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.Error = GError;
+			SaveArgs.SaveFlags = SAVE_NoError;
+		}
+
+		TArray<FSavePackageResultStruct> Results;
+		UPackage::SaveConcurrent(SaveInfos, SaveArgs, Results);
+
+		for (int32 Index = 0; Index < Packages.Num(); Index++) {
+			FJsonPackageSaveResult& Result = Report.Packages.AddDefaulted_GetRef();
+			Result.PackageName = Packages[Index]->GetName();
+			Result.bSaved = Results.IsValidIndex(Index) && Results[Index].Result == ESavePackageResult::Success;
+
+			Result.bSaved ? Report.NumSaved++ : Report.NumFailed++;
+		}
+
+		Report.bConcurrent = true;
+		Report.Seconds = FPlatformTime::Seconds() - StartTime;
+
+		AppendToSession(Report);
+
+		return Report;
+	}
+#endif
+
+	for (UPackage* Package : Packages) {
+		const double PackageStartTime = FPlatformTime::Seconds();
+
+		FJsonPackageSaveResult& Result = Report.Packages.AddDefaulted_GetRef();
+		Result.PackageName = Package->GetName();
+		Result.bSaved = SavePackage(Package);
+		Result.Seconds = FPlatformTime::Seconds() - PackageStartTime;
+
+		Result.bSaved ? Report.NumSaved++ : Report.NumFailed++;
+	}
+
+	Report.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	AppendToSession(Report);
+
+	return Report;
+}
+
+void FJsonPackageSaveQueue::AppendToSession(const FJsonPackageSaveReport& Report) {
+	SessionReport.NumSaved += Report.NumSaved;
+	SessionReport.NumFailed += Report.NumFailed;
+	SessionReport.bConcurrent |= Report.bConcurrent;
+	SessionReport.Seconds += Report.Seconds;
+	SessionReport.Packages.Append(Report.Packages);
+}
+
+void FJsonPackageSaveQueue::Save(UPackage* Package) {
+	if (Package == nullptr) return;
+
+	if (SessionDepth == 0) {
+		SavePackage(Package);
+		return;
+	}
+
+	bool bAlreadyQueued = false;
+	QueuedNames.Add(Package->GetFName(), &bAlreadyQueued);
+
+	if (!bAlreadyQueued) {
+		Queued.Add(Package);
+	}
+}
+
+void FJsonPackageSaveQueue::LogReport(const FJsonPackageSaveReport& Report) {
+	if (Report.Packages.Num() == 0) return;
+
+	for (const FJsonPackageSaveResult& Result : Report.Packages) {
+		if (!Result.bSaved) {
+			UE_LOG(LogJson, Warning, TEXT("Failed to save %s"), *Result.PackageName);
+		} else {
+			UE_LOG(LogJson, Verbose, TEXT("Saved %s (%.3f s)"), *Result.PackageName, Result.Seconds);
+		}
+	}
+
+	UE_LOG(LogJson, Log, TEXT("Saved %d packages%s in %.2f s, %d failed"), Report.NumSaved, Report.bConcurrent ? TEXT(" concurrently") : TEXT(""), Report.Seconds, Report.NumFailed);
+}
+
+bool FJsonPackageSaveQueue::SavePackage(UPackage* Package) {
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+#if ENGINE_MAJOR_VERSION >= 5
+	FSavePackageArgs SaveArgs; {
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GError;
+		SaveArgs.SaveFlags = SAVE_NoError;
+	}
+
+	return UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
+#else
+	return UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
+#endif
+}
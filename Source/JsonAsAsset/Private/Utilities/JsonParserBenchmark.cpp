@@ -0,0 +1,94 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonStreamReader.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Settings/JsonAsAssetSettings.h"
+
+/*
+ * JsonAsAsset.BenchmarkParsers [Directory] [Iterations]
+ *
+ * Parses every export file under Directory (the export directory by default) with the stock
+ * reader and each FJsonStreamReader backend, and logs their throughput. Files are loaded up front
+ * so disk reads aren't measured, the best of Iterations runs is reported.
+ */
+static void BenchmarkParsers(const TArray<FString>& Args) {
+	const FString Directory = Args.Num() > 0 ? Args[0] : GetDefault<UJsonAsAssetSettings>()->ExportDirectory.Path;
+	const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 3;
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *Directory, TEXT("*.json"), true, false);
+
+	TArray<TArray<uint8>> Contents;
+	int64 TotalBytes = 0;
+
+	for (const FString& File : Files) {
+		TArray<uint8>& Data = Contents.AddDefaulted_GetRef();
+
+		if (FFileHelper::LoadFileToArray(Data, *File)) {
+			TotalBytes += Data.Num();
+		}
+	}
+
+	if (TotalBytes == 0) {
+		UE_LOG(LogJson, Warning, TEXT("No export files found in %s"), *Directory);
+		return;
+	}
+
+	auto Measure = [&](const TCHAR* Name, TFunctionRef<bool(const TArray<uint8>& Data)> Parse) {
+		double BestSeconds = TNumericLimits<double>::Max();
+		int32 Failures = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+			Failures = 0;
+
+			const double StartTime = FPlatformTime::Seconds();
+
+			for (const TArray<uint8>& Data : Contents) {
+				if (!Parse(Data)) Failures++;
+			}
+
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+
+		UE_LOG(LogJson, Display, TEXT("%-16s %8.1f MB/s  %.3f s  (%d failed)"), Name, TotalBytes / BestSeconds / (1024.0 * 1024.0), BestSeconds, Failures);
+	};
+
+	UE_LOG(LogJson, Display, TEXT("Benchmarking %d files, %.1f MB, best of %d runs"), Files.Num(), TotalBytes / (1024.0 * 1024.0), Iterations);
+
+	/* What the importer did before: TCHAR conversion, the data wrapper and TJsonReader */
+	Measure(TEXT("TJsonReader"), [](const TArray<uint8>& Data) {
+		FString ContentBefore;
+		FFileHelper::BufferToString(ContentBefore, Data.GetData(), Data.Num());
+
+		FString Content = FString(TEXT("{\"data\": "));
+		Content.Append(ContentBefore);
+		Content.Append(FString("}"));
+
+		TSharedPtr<FJsonObject> JsonParsed;
+		const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Content);
+
+		return FJsonSerializer::Deserialize(JsonReader, JsonParsed);
+	});
+
+	for (const TPair<EJsonReaderBackend, const TCHAR*>& Backend : {
+		TPair<EJsonReaderBackend, const TCHAR*>(EJsonReaderBackend::Scalar, TEXT("Scalar")),
+		TPair<EJsonReaderBackend, const TCHAR*>(EJsonReaderBackend::StructuralIndex, TEXT("StructuralIndex"))
+	}) {
+		Measure(Backend.Value, [&Backend](const TArray<uint8>& Data) {
+			return FJsonStreamReader::ReadArray(Data.GetData(), Data.Num(), [](const TSharedPtr<FJsonValue>&) {
+				return true;
+			}, nullptr, Backend.Key);
+		});
+	}
+}
+
+static FAutoConsoleCommand BenchmarkParsersCommand(
+	TEXT("JsonAsAsset.BenchmarkParsers"),
+	TEXT("Logs the parse throughput of each JSON backend over a directory of exports. Usage: JsonAsAsset.BenchmarkParsers [Directory] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkParsers)
+);
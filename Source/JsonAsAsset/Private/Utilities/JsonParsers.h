@@ -0,0 +1,837 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+/*
+ * UTF-8 JSON parsers shared by FJsonStreamReader and FJsonArenaDocument.
+ *
+ * Parsers only recognise the syntax, values are created by a builder:
+ *
+ *   FValue MakeNull(), MakeBoolean(bool), MakeNumber(double), MakeString(const ANSICHAR* UTF8, int32 Length)
+ *   FKey MakeKey(const ANSICHAR* UTF8, int32 Length)
+ *   int32 BeginObject(), void AddField(FKey&&, FValue&&), FValue EndObject(int32 Marker)
+ *   int32 BeginArray(), void AddElement(FValue&&), FValue EndArray(int32 Marker)
+ *
+ * Strings are handed over as UTF-8 with escapes already resolved.
+ */
+namespace JsonParsers {
+	/* Deeply nested values are never produced by exporters, this only guards the stack */
+	constexpr int32 MaxDepth = 512;
+
+	inline bool IsWhitespace(const uint8 Character) {
+		return Character == ' ' || Character == '\n' || Character == '\r' || Character == '\t';
+	}
+
+	inline bool IsDigit(const uint8 Character) {
+		return Character >= '0' && Character <= '9';
+	}
+
+	/* Drops the elements from Marker onwards, keeping the allocation for the next value */
+	template <typename T>
+	void Truncate(TArray<T>& Array, const int32 Marker) {
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+		Array.SetNum(Marker, EAllowShrinking::No);
+#else
+		Array.SetNum(Marker, false);
+#endif
+	}
+
+	/* Primitives shared by both backends */
+	template <typename TBuilder>
+	struct TParserBase {
+		typedef typename TBuilder::FValue FValue;
+		typedef typename TBuilder::FKey FKey;
+
+		TParserBase(const uint8* Data, const int64 Size, TBuilder& Builder)
+			: Begin(Data), End(Data + Size), Builder(Builder)
+		{
+		}
+
+		const uint8* Begin;
+		const uint8* End;
+
+		TBuilder& Builder;
+
+		int32 Depth = 0;
+		FString Error;
+
+		/* Reused for strings with escapes and for numbers */
+		TArray<ANSICHAR> Scratch;
+
+		bool Fail(const TCHAR* Message, const uint8* Position) {
+			if (Error.IsEmpty()) {
+				Error = FString::Printf(TEXT("%s at byte %lld"), Message, static_cast<int64>(Position - Begin));
+			}
+
+			return false;
+		}
+
+		const uint8* SkipBOM() const {
+			if (End - Begin >= 3 && Begin[0] == 0xEF && Begin[1] == 0xBB && Begin[2] == 0xBF) {
+				return Begin + 3;
+			}
+
+			return Begin;
+		}
+
+		static int32 HexDigit(const uint8 Character) {
+			if (Character >= '0' && Character <= '9') return Character - '0';
+			if (Character >= 'a' && Character <= 'f') return Character - 'a' + 10;
+			if (Character >= 'A' && Character <= 'F') return Character - 'A' + 10;
+
+			return -1;
+		}
+
+		bool ReadHex4(const uint8*& Position, const uint8* Stop, uint32& OutCodeUnit) {
+			if (Stop - Position < 4) return Fail(TEXT("Truncated unicode escape"), Position);
+
+			OutCodeUnit = 0;
+
+			for (int32 i = 0; i < 4; i++) {
+				const int32 Digit = HexDigit(Position[i]);
+				if (Digit < 0) return Fail(TEXT("Invalid unicode escape"), Position);
+
+				OutCodeUnit = (OutCodeUnit << 4) | Digit;
+			}
+
+			Position += 4;
+			return true;
+		}
+
+		void AppendUTF8(const uint32 CodePoint) {
+			if (CodePoint < 0x80) {
+				Scratch.Add(static_cast<ANSICHAR>(CodePoint));
+			} else if (CodePoint < 0x800) {
+				Scratch.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			} else if (CodePoint < 0x10000) {
+				Scratch.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			} else {
+				Scratch.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Scratch.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+		}
+
+		/*
+		 * Resolves the contents of a string, [Start, Stop) excludes both quotes. Strings without
+		 * escapes point straight into the input, others into Scratch.
+		 */
+		bool DecodeString(const uint8* Start, const uint8* Stop, const bool bHasEscapes, const ANSICHAR*& OutUTF8, int32& OutLength) {
+			if (!bHasEscapes) {
+				OutUTF8 = reinterpret_cast<const ANSICHAR*>(Start);
+				OutLength = static_cast<int32>(Stop - Start);
+
+				return true;
+			}
+
+			Scratch.Reset();
+
+			const uint8* Position = Start;
+
+			while (Position < Stop) {
+				const uint8* Run = Position;
+
+				while (Position < Stop && *Position != '\\') {
+					Position++;
+				}
+
+				Scratch.Append(reinterpret_cast<const ANSICHAR*>(Run), static_cast<int32>(Position - Run));
+
+				if (Position >= Stop) break;
+
+				/* Skip the backslash */
+				if (++Position >= Stop) return Fail(TEXT("Invalid escape sequence"), Position);
+
+				switch (*Position++) {
+					case '"': Scratch.Add('"'); break;
+					case '\\': Scratch.Add('\\'); break;
+					case '/': Scratch.Add('/'); break;
+					case 'b': Scratch.Add('\b'); break;
+					case 'f': Scratch.Add('\f'); break;
+					case 'n': Scratch.Add('\n'); break;
+					case 'r': Scratch.Add('\r'); break;
+					case 't': Scratch.Add('\t'); break;
+
+					case 'u': {
+						uint32 CodePoint;
+						if (!ReadHex4(Position, Stop, CodePoint)) return false;
+
+						/* Join surrogate pairs, lone surrogates become U+FFFD */
+						if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF) {
+							uint32 Low = 0;
+
+							if (Stop - Position >= 6 && Position[0] == '\\' && Position[1] == 'u') {
+								Position += 2;
+								if (!ReadHex4(Position, Stop, Low)) return false;
+							}
+
+							if (Low >= 0xDC00 && Low <= 0xDFFF) {
+								CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+							} else if (Low != 0) {
+								AppendUTF8(0xFFFD);
+
+								CodePoint = Low;
+							} else {
+								CodePoint = 0xFFFD;
+							}
+						}
+
+						if (CodePoint >= 0xD800 && CodePoint <= 0xDFFF) {
+							CodePoint = 0xFFFD;
+						}
+
+						AppendUTF8(CodePoint);
+						break;
+					}
+
+					default:
+						return Fail(TEXT("Invalid escape sequence"), Position - 1);
+				}
+			}
+
+			OutUTF8 = Scratch.GetData();
+			OutLength = Scratch.Num();
+
+			return true;
+		}
+
+		void SkipDigits(const uint8*& Position) const {
+			while (Position < End && IsDigit(*Position)) {
+				Position++;
+			}
+		}
+
+		bool ParseLiteral(const uint8*& Position, const char* Literal, const int32 Length) {
+			if (End - Position < Length || FMemory::Memcmp(Position, Literal, Length) != 0) {
+				return Fail(TEXT("Invalid literal"), Position);
+			}
+
+			Position += Length;
+			return true;
+		}
+
+		/* Parses a number, true, false or null, Position is left on the byte after it */
+		bool ParseScalar(const uint8*& Position, FValue& OutValue) {
+			switch (*Position) {
+				case 't':
+					if (!ParseLiteral(Position, "true", 4)) return false;
+
+					OutValue = Builder.MakeBoolean(true);
+					return true;
+
+				case 'f':
+					if (!ParseLiteral(Position, "false", 5)) return false;
+
+					OutValue = Builder.MakeBoolean(false);
+					return true;
+
+				case 'n':
+					if (!ParseLiteral(Position, "null", 4)) return false;
+
+					OutValue = Builder.MakeNull();
+					return true;
+
+				default:
+					break;
+			}
+
+			const uint8* Start = Position;
+
+			/* -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, a leading zero ends the integer part */
+			if (*Position == '-') Position++;
+
+			if (Position == End || !IsDigit(*Position)) {
+				return Fail(Position == Start ? TEXT("Unexpected character") : TEXT("Invalid number"), Position);
+			}
+
+			if (*Position++ != '0') {
+				SkipDigits(Position);
+			}
+
+			if (Position < End && *Position == '.') {
+				if (++Position == End || !IsDigit(*Position)) return Fail(TEXT("Invalid number"), Position);
+
+				SkipDigits(Position);
+			}
+
+			if (Position < End && (*Position == 'e' || *Position == 'E')) {
+				if (++Position < End && (*Position == '+' || *Position == '-')) Position++;
+				if (Position == End || !IsDigit(*Position)) return Fail(TEXT("Invalid number"), Position);
+
+				SkipDigits(Position);
+			}
+
+			Scratch.Reset();
+			Scratch.Append(reinterpret_cast<const ANSICHAR*>(Start), static_cast<int32>(Position - Start));
+			Scratch.Add('\0');
+
+			OutValue = Builder.MakeNumber(FCStringAnsi::Atod(Scratch.GetData()));
+			return true;
+		}
+	};
+
+	/* Byte by byte recursive descent */
+	template <typename TBuilder>
+	struct TScalarParser : TParserBase<TBuilder> {
+		typedef TParserBase<TBuilder> Super;
+		typedef typename Super::FValue FValue;
+		typedef typename Super::FKey FKey;
+
+		using Super::Begin;
+		using Super::End;
+		using Super::Builder;
+		using Super::Depth;
+		using Super::Fail;
+
+		TScalarParser(const uint8* Data, const int64 Size, TBuilder& Builder)
+			: Super(Data, Size, Builder), Current(Data)
+		{
+		}
+
+		const uint8* Current;
+
+		void SkipWhitespace() {
+			while (Current < End && IsWhitespace(*Current)) {
+				Current++;
+			}
+		}
+
+		bool Consume(const char Character) {
+			SkipWhitespace();
+
+			if (Current < End && *Current == Character) {
+				Current++;
+				return true;
+			}
+
+			return false;
+		}
+
+		/* OnElement(FValue&&) returns false to stop reading */
+		template <typename TOnElement>
+		bool ParseRootArray(TOnElement&& OnElement) {
+			Current = Super::SkipBOM();
+
+			if (!Consume('[')) return Fail(TEXT("Expected an array as the root value"), Current);
+
+			if (!Consume(']')) {
+				Depth++;
+
+				while (true) {
+					FValue Element;
+					if (!ParseValue(Element)) return false;
+
+					if (!OnElement(MoveTemp(Element))) return true;
+
+					if (Consume(',')) continue;
+					if (Consume(']')) break;
+
+					return Fail(TEXT("Expected ',' or ']' in the root array"), Current);
+				}
+			}
+
+			SkipWhitespace();
+
+			if (Current != End) return Fail(TEXT("Unexpected data after the root array"), Current);
+
+			return true;
+		}
+
+		bool ParseValue(FValue& OutValue) {
+			SkipWhitespace();
+
+			if (Current >= End) return Fail(TEXT("Unexpected end of data"), Current);
+
+			switch (*Current) {
+				case '{': return ParseObject(OutValue);
+				case '[': return ParseArray(OutValue);
+
+				case '"': {
+					const ANSICHAR* UTF8;
+					int32 Length;
+					if (!ParseString(UTF8, Length)) return false;
+
+					OutValue = Builder.MakeString(UTF8, Length);
+					return true;
+				}
+
+				default:
+					return Super::ParseScalar(Current, OutValue);
+			}
+		}
+
+		bool ParseObject(FValue& OutValue) {
+			if (++Depth > MaxDepth) return Fail(TEXT("Maximum nesting depth exceeded"), Current);
+
+			/* Skip '{' */
+			Current++;
+
+			const int32 Marker = Builder.BeginObject();
+
+			if (!Consume('}')) {
+				while (true) {
+					SkipWhitespace();
+
+					if (Current >= End || *Current != '"') return Fail(TEXT("Expected a string as an object key"), Current);
+
+					const ANSICHAR* UTF8;
+					int32 Length;
+					if (!ParseString(UTF8, Length)) return false;
+
+					FKey Key = Builder.MakeKey(UTF8, Length);
+
+					if (!Consume(':')) return Fail(TEXT("Expected ':' after an object key"), Current);
+
+					FValue Value;
+					if (!ParseValue(Value)) return false;
+
+					Builder.AddField(MoveTemp(Key), MoveTemp(Value));
+
+					if (Consume(',')) continue;
+					if (Consume('}')) break;
+
+					return Fail(TEXT("Expected ',' or '}' in an object"), Current);
+				}
+			}
+
+			Depth--;
+
+			OutValue = Builder.EndObject(Marker);
+			return true;
+		}
+
+		bool ParseArray(FValue& OutValue) {
+			if (++Depth > MaxDepth) return Fail(TEXT("Maximum nesting depth exceeded"), Current);
+
+			/* Skip '[' */
+			Current++;
+
+			const int32 Marker = Builder.BeginArray();
+
+			if (!Consume(']')) {
+				while (true) {
+					FValue Element;
+					if (!ParseValue(Element)) return false;
+
+					Builder.AddElement(MoveTemp(Element));
+
+					if (Consume(',')) continue;
+					if (Consume(']')) break;
+
+					return Fail(TEXT("Expected ',' or ']' in an array"), Current);
+				}
+			}
+
+			Depth--;
+
+			OutValue = Builder.EndArray(Marker);
+			return true;
+		}
+
+		bool ParseString(const ANSICHAR*& OutUTF8, int32& OutLength) {
+			/* Skip the opening quote */
+			const uint8* Start = ++Current;
+			bool bHasEscapes = false;
+
+			while (Current < End && *Current != '"') {
+				if (*Current == '\\') {
+					bHasEscapes = true;
+
+					if (++Current >= End) break;
+				}
+
+				Current++;
+			}
+
+			if (Current >= End) return Fail(TEXT("Unterminated string"), Start - 1);
+
+			if (!Super::DecodeString(Start, Current, bHasEscapes, OutUTF8, OutLength)) return false;
+
+			/* Skip the closing quote */
+			Current++;
+			return true;
+		}
+	};
+
+	/*
+	 * Stage one of simdjson: classifies 64 bytes at a time into bitmasks, works out which quotes
+	 * are escaped and which bytes are inside strings, then records the offsets of every operator,
+	 * quote and scalar start. Offsets are produced in batches so memory stays bounded on huge files.
+	 */
+	class FStructuralIndexer {
+	public:
+		FStructuralIndexer(const uint8* Data, const int64 Size, const int64 StartOffset)
+			: Data(Data), Size(Size), Offset(StartOffset)
+		{
+			Indices.Reserve(BatchSize + 64);
+		}
+
+		/* Offset of the next structural byte, false once the input is exhausted */
+		bool Next(int64& OutPosition) {
+			if (Read == Indices.Num() && !Refill()) return false;
+
+			OutPosition = Indices[Read++];
+			return true;
+		}
+
+	private:
+		static constexpr int32 BatchSize = 16384;
+
+		const uint8* Data;
+		int64 Size;
+		int64 Offset;
+
+		TArray<int64> Indices;
+		int32 Read = 0;
+
+		/* Carried over from the previous block */
+		uint64 PrevEscaped = 0;
+		uint64 PrevInString = 0;
+		uint64 PrevScalar = 0;
+
+		bool Refill() {
+			Indices.Reset();
+			Read = 0;
+
+			while (Offset < Size && Indices.Num() < BatchSize) {
+				IndexBlock();
+			}
+
+			return Indices.Num() > 0;
+		}
+
+		static uint64 PrefixXor(uint64 Bits) {
+			Bits ^= Bits << 1;
+			Bits ^= Bits << 2;
+			Bits ^= Bits << 4;
+			Bits ^= Bits << 8;
+			Bits ^= Bits << 16;
+			Bits ^= Bits << 32;
+
+			return Bits;
+		}
+
+		static void Classify(const uint8* Block, uint64& OutBackslash, uint64& OutQuote, uint64& OutWhitespace, uint64& OutOperator) {
+			OutBackslash = OutQuote = OutWhitespace = OutOperator = 0;
+
+#if PLATFORM_CPU_X86_FAMILY
+			for (int32 i = 0; i < 4; i++) {
+				const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + i * 16));
+
+				/* Setting bit 5 folds '[' into '{' and ']' into '}' */
+				const __m128i Folded = _mm_or_si128(Chunk, _mm_set1_epi8(0x20));
+
+				const __m128i Whitespace = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n'))),
+					_mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t')))
+				);
+
+				const __m128i Operator = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(Folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(Folded, _mm_set1_epi8('}'))),
+					_mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(',')))
+				);
+
+				const int32 Shift = i * 16;
+
+				OutBackslash |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\\'))))) << Shift;
+				OutQuote |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('"'))))) << Shift;
+				OutWhitespace |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(Whitespace))) << Shift;
+				OutOperator |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(Operator))) << Shift;
+			}
+#else
+			for (int32 i = 0; i < 64; i++) {
+				const uint8 Character = Block[i];
+				const uint64 Bit = 1ull << i;
+
+				if (Character == '\\') OutBackslash |= Bit;
+				else if (Character == '"') OutQuote |= Bit;
+				else if (IsWhitespace(Character)) OutWhitespace |= Bit;
+				else if (Character == '{' || Character == '}' || Character == '[' || Character == ']' || Character == ':' || Character == ',') OutOperator |= Bit;
+			}
+#endif
+		}
+
+		void IndexBlock() {
+			const uint8* Block = Data + Offset;
+
+			/* The tail is padded with whitespace, which never produces an offset */
+			uint8 Padded[64];
+
+			if (Size - Offset < 64) {
+				FMemory::Memset(Padded, ' ', 64);
+				FMemory::Memcpy(Padded, Block, Size - Offset);
+
+				Block = Padded;
+			}
+
+			uint64 Backslash, Quote, Whitespace, Operator;
+			Classify(Block, Backslash, Quote, Whitespace, Operator);
+
+			/* Bytes preceded by an odd run of backslashes */
+			uint64 Escaped;
+
+			if (Backslash == 0) {
+				Escaped = PrevEscaped;
+				PrevEscaped = 0;
+			} else {
+				constexpr uint64 EvenBits = 0x5555555555555555ull;
+
+				Backslash &= ~PrevEscaped;
+
+				const uint64 FollowsEscape = Backslash << 1 | PrevEscaped;
+				const uint64 OddSequenceStarts = Backslash & ~EvenBits & ~FollowsEscape;
+				const uint64 SequencesStartingOnEvenBits = OddSequenceStarts + Backslash;
+
+				/* The add overflowed, so a run of backslashes continues into the next block */
+				PrevEscaped = SequencesStartingOnEvenBits < Backslash ? 1 : 0;
+
+				Escaped = (EvenBits ^ (SequencesStartingOnEvenBits << 1)) & FollowsEscape;
+			}
+
+			Quote &= ~Escaped;
+
+			/* Set from an opening quote up to (not including) its closing quote */
+			const uint64 InString = PrefixXor(Quote) ^ PrevInString;
+			PrevInString = static_cast<uint64>(static_cast<int64>(InString) >> 63);
+
+			const uint64 Scalar = ~(Operator | Whitespace | InString | Quote);
+			const uint64 ScalarStart = Scalar & ~(Scalar << 1 | PrevScalar);
+			PrevScalar = Scalar >> 63;
+
+			uint64 Structurals = (Operator & ~InString) | Quote | ScalarStart;
+
+			while (Structurals != 0) {
+				Indices.Add(Offset + FPlatformMath::CountTrailingZeros64(Structurals));
+				Structurals &= Structurals - 1;
+			}
+
+			Offset += 64;
+		}
+	};
+
+	/* Stage two: walks the structural offsets, so whitespace and string contents are never scanned */
+	template <typename TBuilder>
+	struct TIndexedParser : TParserBase<TBuilder> {
+		typedef TParserBase<TBuilder> Super;
+		typedef typename Super::FValue FValue;
+		typedef typename Super::FKey FKey;
+
+		using Super::Begin;
+		using Super::End;
+		using Super::Builder;
+		using Super::Depth;
+		using Super::Fail;
+
+		TIndexedParser(const uint8* Data, const int64 Size, TBuilder& Builder)
+			: Super(Data, Size, Builder), Indexer(Data, Size, Super::SkipBOM() - Data)
+		{
+		}
+
+		FStructuralIndexer Indexer;
+
+		bool Next(int64& OutPosition, const TCHAR* ErrorIfMissing) {
+			if (Indexer.Next(OutPosition)) return true;
+
+			return Fail(ErrorIfMissing, End);
+		}
+
+		/* OnElement(FValue&&) returns false to stop reading */
+		template <typename TOnElement>
+		bool ParseRootArray(TOnElement&& OnElement) {
+			int64 Position;
+
+			if (!Indexer.Next(Position) || Begin[Position] != '[') return Fail(TEXT("Expected an array as the root value"), Super::SkipBOM());
+			if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+
+			if (Begin[Position] != ']') {
+				Depth++;
+
+				while (true) {
+					FValue Element;
+					if (!ParseValue(Position, Element)) return false;
+
+					if (!OnElement(MoveTemp(Element))) return true;
+
+					if (!Next(Position, TEXT("Expected ',' or ']' in the root array"))) return false;
+
+					if (Begin[Position] == ',') {
+						if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+						continue;
+					}
+
+					if (Begin[Position] == ']') break;
+
+					return Fail(TEXT("Expected ',' or ']' in the root array"), Begin + Position);
+				}
+			}
+
+			if (Indexer.Next(Position)) return Fail(TEXT("Unexpected data after the root array"), Begin + Position);
+
+			return true;
+		}
+
+		bool ParseValue(const int64 Position, FValue& OutValue) {
+			switch (Begin[Position]) {
+				case '{': return ParseObject(Position, OutValue);
+				case '[': return ParseArray(Position, OutValue);
+
+				case '"': {
+					const ANSICHAR* UTF8;
+					int32 Length;
+					if (!ParseString(Position, UTF8, Length)) return false;
+
+					OutValue = Builder.MakeString(UTF8, Length);
+					return true;
+				}
+
+				case '}':
+				case ']':
+				case ':':
+				case ',':
+					return Fail(TEXT("Unexpected character"), Begin + Position);
+
+				default: {
+					const uint8* Current = Begin + Position;
+					if (!Super::ParseScalar(Current, OutValue)) return false;
+
+					/* Scalars run until whitespace or an operator, anything else is left over */
+					if (Current < End && !IsWhitespace(*Current) && *Current != ',' && *Current != ']' && *Current != '}') {
+						return Fail(TEXT("Unexpected character"), Current);
+					}
+
+					return true;
+				}
+			}
+		}
+
+		bool ParseObject(const int64 OpenPosition, FValue& OutValue) {
+			if (++Depth > MaxDepth) return Fail(TEXT("Maximum nesting depth exceeded"), Begin + OpenPosition);
+
+			const int32 Marker = Builder.BeginObject();
+
+			int64 Position;
+			if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+
+			if (Begin[Position] != '}') {
+				while (true) {
+					if (Begin[Position] != '"') return Fail(TEXT("Expected a string as an object key"), Begin + Position);
+
+					const ANSICHAR* UTF8;
+					int32 Length;
+					if (!ParseString(Position, UTF8, Length)) return false;
+
+					FKey Key = Builder.MakeKey(UTF8, Length);
+
+					if (!Next(Position, TEXT("Expected ':' after an object key")) || Begin[Position] != ':') {
+						return Fail(TEXT("Expected ':' after an object key"), Begin + Position);
+					}
+
+					if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+
+					FValue Value;
+					if (!ParseValue(Position, Value)) return false;
+
+					Builder.AddField(MoveTemp(Key), MoveTemp(Value));
+
+					if (!Next(Position, TEXT("Expected ',' or '}' in an object"))) return false;
+
+					if (Begin[Position] == ',') {
+						if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+						continue;
+					}
+
+					if (Begin[Position] == '}') break;
+
+					return Fail(TEXT("Expected ',' or '}' in an object"), Begin + Position);
+				}
+			}
+
+			Depth--;
+
+			OutValue = Builder.EndObject(Marker);
+			return true;
+		}
+
+		bool ParseArray(const int64 OpenPosition, FValue& OutValue) {
+			if (++Depth > MaxDepth) return Fail(TEXT("Maximum nesting depth exceeded"), Begin + OpenPosition);
+
+			const int32 Marker = Builder.BeginArray();
+
+			int64 Position;
+			if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+
+			if (Begin[Position] != ']') {
+				while (true) {
+					FValue Element;
+					if (!ParseValue(Position, Element)) return false;
+
+					Builder.AddElement(MoveTemp(Element));
+
+					if (!Next(Position, TEXT("Expected ',' or ']' in an array"))) return false;
+
+					if (Begin[Position] == ',') {
+						if (!Next(Position, TEXT("Unexpected end of data"))) return false;
+						continue;
+					}
+
+					if (Begin[Position] == ']') break;
+
+					return Fail(TEXT("Expected ',' or ']' in an array"), Begin + Position);
+				}
+			}
+
+			Depth--;
+
+			OutValue = Builder.EndArray(Marker);
+			return true;
+		}
+
+		bool ParseString(const int64 OpenPosition, const ANSICHAR*& OutUTF8, int32& OutLength) {
+			/* Nothing inside a string is structural, so the next offset is the closing quote */
+			int64 ClosePosition;
+			if (!Indexer.Next(ClosePosition)) return Fail(TEXT("Unterminated string"), Begin + OpenPosition);
+
+			const uint8* Start = Begin + OpenPosition + 1;
+			const uint8* Stop = Begin + ClosePosition;
+
+			bool bHasEscapes = false;
+
+			for (const uint8* Position = Start; Position < Stop; Position++) {
+				if (*Position == '\\') {
+					bHasEscapes = true;
+					break;
+				}
+			}
+
+			return Super::DecodeString(Start, Stop, bHasEscapes, OutUTF8, OutLength);
+		}
+	};
+
+	/* Runs whichever backend was asked for over a root array, OutError is set on failure */
+	template <typename TBuilder, typename TOnElement>
+	bool ParseRootArray(const uint8* Data, const int64 Size, TBuilder& Builder, const bool bStructuralIndex, TOnElement&& OnElement, FString& OutError) {
+		if (bStructuralIndex) {
+			TIndexedParser<TBuilder> Parser(Data, Size, Builder);
+			if (Parser.ParseRootArray(Forward<TOnElement>(OnElement))) return true;
+
+			OutError = MoveTemp(Parser.Error);
+			return false;
+		}
+
+		TScalarParser<TBuilder> Parser(Data, Size, Builder);
+		if (Parser.ParseRootArray(Forward<TOnElement>(OnElement))) return true;
+
+		OutError = MoveTemp(Parser.Error);
+		return false;
+	}
+}
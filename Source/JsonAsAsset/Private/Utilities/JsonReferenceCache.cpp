@@ -0,0 +1,99 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonReferenceCache.h"
+
+#include "Settings/JsonAsAssetSettings.h"
+
+FJsonReferenceCache& FJsonReferenceCache::Get() {
+	static FJsonReferenceCache Cache;
+	return Cache;
+}
+
+void FJsonReferenceCache::BeginSession() {
+	check(IsInGameThread());
+
+	SessionDepth++;
+}
+
+void FJsonReferenceCache::EndSession() {
+	check(IsInGameThread());
+	check(SessionDepth > 0);
+
+	if (--SessionDepth > 0) return;
+
+	Names.Empty();
+	Packages.Empty();
+}
+
+FJsonReferenceName FJsonReferenceCache::Parse(const FJsonObject& Reference) {
+	const FString& ObjectName = Reference.GetStringField(TEXT("ObjectName"));
+	const FString& ObjectPath = Reference.GetStringField(TEXT("ObjectPath"));
+
+	if (SessionDepth == 0) {
+		return ParseUncached(ObjectName, ObjectPath);
+	}
+
+	const TPair<FString, FString> Key(ObjectName, ObjectPath);
+
+	if (const FJsonReferenceName* Found = Names.Find(Key)) {
+		return *Found;
+	}
+
+	return Names.Add(Key, ParseUncached(ObjectName, ObjectPath));
+}
+
+UObject* FJsonReferenceCache::Load(const FString& ObjectPath) {
+	if (SessionDepth == 0) {
+		return StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPath);
+	}
+
+	FString PackageName = ObjectPath;
+	ObjectPath.Split(".", &PackageName, nullptr);
+
+	FLoadResult& Result = Packages.FindOrAdd(PackageName).FindOrAdd(ObjectPath);
+
+	if (Result.bMissing) return nullptr;
+
+	/* Not looked up yet, or collected since */
+	if (!Result.Object.IsValid()) {
+		UObject* Object = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPath);
+
+		Result.Object = Object;
+		Result.bMissing = Object == nullptr;
+	}
+
+	return Result.Object.Get();
+}
+
+void FJsonReferenceCache::Invalidate(const FString& PackageName) {
+	if (SessionDepth == 0) return;
+
+	Packages.Remove(PackageName);
+}
+
+FJsonReferenceName FJsonReferenceCache::ParseUncached(const FString& ObjectName, const FString& ObjectPath) {
+	FJsonReferenceName Result;
+
+	ObjectName.Split("'", &Result.Type, &Result.Name);
+	ObjectPath.Split(".", &Result.Path, nullptr);
+
+	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
+
+	/* Rare case of needing a GameName */
+	if (!Settings->AssetSettings.GameName.IsEmpty()) {
+		Result.Path = Result.Path.Replace(*(Settings->AssetSettings.GameName + "/Content"), TEXT("/Game"));
+	}
+
+	Result.Path = Result.Path.Replace(TEXT("Engine/Content"), TEXT("/Engine"));
+	Result.Name = Result.Name.Replace(TEXT("'"), TEXT(""));
+
+	if (Result.Name.Contains(".")) {
+		Result.Name.Split(".", nullptr, &Result.Name);
+	}
+
+	if (Result.Name.Contains(".")) {
+		Result.Name.Split(".", &Result.Outer, &Result.Name);
+	}
+
+	return Result;
+}
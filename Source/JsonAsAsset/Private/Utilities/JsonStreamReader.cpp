@@ -0,0 +1,193 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonStreamReader.h"
+
+#include "Utilities/JsonExportCache.h"
+#include "Utilities/JsonParsers.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarStructuralIndexParser(
+	TEXT("JsonAsAsset.StructuralIndexParser"),
+	0,
+	TEXT("1 to parse export files with the structural index backend, 0 for the byte by byte parser."),
+	ECVF_Default
+);
+
+namespace {
+	/* Builds the engine's FJsonValue DOM */
+	struct FJsonValueBuilder {
+		typedef TSharedPtr<FJsonValue> FValue;
+		typedef FString FKey;
+
+		/* Fields and elements of every object and array still being parsed */
+		TArray<TPair<FString, TSharedPtr<FJsonValue>>> Fields;
+		TArray<TSharedPtr<FJsonValue>> Elements;
+
+		static FString ToString(const ANSICHAR* UTF8, const int32 Length) {
+			if (Length == 0) return FString();
+
+			const FUTF8ToTCHAR Converted(UTF8, Length);
+			return FString(Converted.Length(), Converted.Get());
+		}
+
+		FValue MakeNull() { return MakeShared<FJsonValueNull>(); }
+		FValue MakeBoolean(const bool bValue) { return MakeShared<FJsonValueBoolean>(bValue); }
+		FValue MakeNumber(const double Number) { return MakeShared<FJsonValueNumber>(Number); }
+		FValue MakeString(const ANSICHAR* UTF8, const int32 Length) { return MakeShared<FJsonValueString>(ToString(UTF8, Length)); }
+		FKey MakeKey(const ANSICHAR* UTF8, const int32 Length) { return ToString(UTF8, Length); }
+
+		int32 BeginObject() const { return Fields.Num(); }
+
+		void AddField(FKey&& Key, FValue&& Value) {
+			Fields.Emplace(MoveTemp(Key), MoveTemp(Value));
+		}
+
+		FValue EndObject(const int32 Marker) {
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->Values.Reserve(Fields.Num() - Marker);
+
+			for (int32 i = Marker; i < Fields.Num(); i++) {
+				/* Duplicate keys overwrite, same as FJsonObject::SetField */
+				Object->Values.Add(MoveTemp(Fields[i].Key), MoveTemp(Fields[i].Value));
+			}
+
+			JsonParsers::Truncate(Fields, Marker);
+
+			return MakeShared<FJsonValueObject>(Object);
+		}
+
+		int32 BeginArray() const { return Elements.Num(); }
+
+		void AddElement(FValue&& Value) {
+			Elements.Add(MoveTemp(Value));
+		}
+
+		FValue EndArray(const int32 Marker) {
+			TArray<TSharedPtr<FJsonValue>> Array;
+			Array.Reserve(Elements.Num() - Marker);
+
+			for (int32 i = Marker; i < Elements.Num(); i++) {
+				Array.Add(MoveTemp(Elements[i]));
+			}
+
+			JsonParsers::Truncate(Elements, Marker);
+
+			return MakeShared<FJsonValueArray>(Array);
+		}
+	};
+}
+
+bool FJsonStreamReader::UseStructuralIndex(const EJsonReaderBackend Backend) {
+	if (Backend == EJsonReaderBackend::Default) {
+		return CVarStructuralIndexParser.GetValueOnAnyThread() != 0;
+	}
+
+	return Backend == EJsonReaderBackend::StructuralIndex;
+}
+
+bool FJsonStreamReader::ReadArray(const uint8* Data, const int64 Size, const FOnElement OnElement, FString* OutError, const EJsonReaderBackend Backend) {
+	FJsonValueBuilder Builder;
+	FString Error;
+
+	if (JsonParsers::ParseRootArray(Data, Size, Builder, UseStructuralIndex(Backend), [&OnElement](TSharedPtr<FJsonValue>&& Element) {
+		return OnElement(Element);
+	}, Error)) return true;
+
+	if (OutError != nullptr) {
+		*OutError = MoveTemp(Error);
+	}
+
+	return false;
+}
+
+bool FJsonStreamReader::ReadArrayFile(const FString& FilePath, const FOnElement OnElement, FString* OutError) {
+	FJsonFileView File;
+	if (!File.Open(FilePath, OutError)) return false;
+
+	return ReadArray(File.GetData(), File.Num(), OnElement, OutError);
+}
+
+bool FJsonStreamReader::LoadArrayFile(const FString& FilePath, TArray<TSharedPtr<FJsonValue>>& OutElements, FString* OutError) {
+	OutElements.Reset();
+
+	if (FJsonExportCache::Load(FilePath, OutElements)) return true;
+
+	/* Before reading, so an edit made meanwhile leaves the cache older than the file */
+	const FJsonExportCache::FStamp Stamp = FJsonExportCache::GetStamp(FPaths::ConvertRelativePathToFull(FilePath));
+
+	FJsonFileView File;
+	if (!File.Open(FilePath, OutError)) return false;
+
+	if (!ReadArray(File.GetData(), File.Num(), [&OutElements](const TSharedPtr<FJsonValue>& Element) {
+		OutElements.Add(Element);
+		return true;
+	}, OutError)) return false;
+
+	FJsonExportCache::Save(FilePath, Stamp, File.GetData(), File.Num(), OutElements);
+	return true;
+}
+
+FJsonFileView::~FJsonFileView() {
+	Reset();
+}
+
+bool FJsonFileView::Open(const FString& FilePath, FString* OutError) {
+	Reset();
+
+	/* Platforms without mapped file support return nullptr here, and so do empty files */
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+
+	if (Handle.IsValid() && Handle->GetFileSize() > 0) {
+		Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+	}
+
+	if (Region.IsValid()) {
+		Data = Region->GetMappedPtr();
+		Size = Region->GetMappedSize();
+	} else {
+		Handle.Reset();
+
+		if (!FFileHelper::LoadFileToArray(Buffer, *FilePath)) {
+			if (OutError != nullptr) {
+				*OutError = FString::Printf(TEXT("Failed to load %s"), *FilePath);
+			}
+
+			return false;
+		}
+
+		Data = Buffer.GetData();
+		Size = Buffer.Num();
+	}
+
+	/* UTF-16 files are rare, let FFileHelper decode them and parse the UTF-8 of that */
+	if (Size >= 2 && ((Data[0] == 0xFF && Data[1] == 0xFE) || (Data[0] == 0xFE && Data[1] == 0xFF))) {
+		FString Content;
+		FFileHelper::BufferToString(Content, Data, Size);
+
+		const FTCHARToUTF8 Converted(*Content);
+		Buffer = TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+
+		Region.Reset();
+		Handle.Reset();
+
+		Data = Buffer.GetData();
+		Size = Buffer.Num();
+	}
+
+	return true;
+}
+
+void FJsonFileView::Reset() {
+	Region.Reset();
+	Handle.Reset();
+	Buffer.Empty();
+
+	Data = nullptr;
+	Size = 0;
+}
@@ -0,0 +1,81 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/JsonTypeCache.h"
+
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+FJsonTypeCache& FJsonTypeCache::Get() {
+	static FJsonTypeCache Cache;
+	return Cache;
+}
+
+void FJsonTypeCache::Shutdown() {
+	if (ModulesChangedHandle.IsValid()) {
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+
+	if (ObjectsReplacedHandle.IsValid()) {
+		FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+		ObjectsReplacedHandle.Reset();
+	}
+
+	Reset();
+}
+
+void FJsonTypeCache::ForgetMisses() {
+	Misses.Reset();
+}
+
+void FJsonTypeCache::Reset() {
+	Types.Reset();
+	Misses.Reset();
+}
+
+UObject* FJsonTypeCache::FindType(UClass* TypeClass, const FString& Name) {
+	if (!ModulesChangedHandle.IsValid()) {
+		/* New modules bring new types, unloaded ones take theirs with them */
+		ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([this](FName, EModuleChangeReason) {
+			Reset();
+		});
+
+		/* Types held here may be the ones that were just replaced */
+		ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>&) {
+			Reset();
+		});
+	}
+
+	const FKey Key(TypeClass, FName(*Name));
+
+	if (const TWeakObjectPtr<UObject>* Found = Types.Find(Key)) {
+		/* A class left behind by a recompile stays valid, but isn't the type anymore */
+		if (Found->IsValid() && !Found->Get()->HasAnyFlags(RF_NewerVersionExists)) return Found->Get();
+	} else if (Misses.Contains(Key)) {
+		return nullptr;
+	}
+
+#if ENGINE_MAJOR_VERSION > 5 || ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+	UObject* Type = StaticFindFirstObject(TypeClass, *Name, EFindFirstObjectOptions::None);
+#else
+	UObject* Type = StaticFindObject(TypeClass, ANY_PACKAGE, *Name);
+#endif
+
+	if (Type != nullptr) {
+		Types.Add(Key, Type);
+	} else {
+		Types.Remove(Key);
+		Misses.Add(Key);
+	}
+
+	return Type;
+}
+
+void FJsonTypeCache::RememberType(UClass* TypeClass, const FString& Name, UObject* Type) {
+	if (Type == nullptr) return;
+
+	const FKey Key(TypeClass, FName(*Name));
+
+	Misses.Remove(Key);
+	Types.Add(Key, Type);
+}
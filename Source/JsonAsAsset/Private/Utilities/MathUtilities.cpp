@@ -2,6 +2,7 @@
 
 #include "Utilities/MathUtilities.h"
 #include "Dom/JsonObject.h"
+#include "Utilities/JsonEnumCache.h"
 
 FVector FMathUtilities::ObjectToVector(const FJsonObject* Object) {
 	return FVector(Object->GetNumberField(TEXT("X")), Object->GetNumberField(TEXT("Y")), Object->GetNumberField(TEXT("Z")));
@@ -58,5 +59,5 @@ FFloatInterval FMathUtilities::ObjectToFloatInterval(const FJsonObject* Object)
 
 FRichCurveKey FMathUtilities::ObjectToRichCurveKey(const TSharedPtr<FJsonObject>& Object) {
 	FString InterpMode = Object->GetStringField(TEXT("InterpMode"));
-	return FRichCurveKey(Object->GetNumberField(TEXT("Time")), Object->GetNumberField(TEXT("Value")), Object->GetNumberField(TEXT("ArriveTangent")), Object->GetNumberField(TEXT("LeaveTangent")), static_cast<ERichCurveInterpMode>(StaticEnum<ERichCurveInterpMode>()->GetValueByNameString(InterpMode)));
+	return FRichCurveKey(Object->GetNumberField(TEXT("Time")), Object->GetNumberField(TEXT("Value")), Object->GetNumberField(TEXT("ArriveTangent")), Object->GetNumberField(TEXT("LeaveTangent")), static_cast<ERichCurveInterpMode>(FJsonEnumCache::Get().GetValue(StaticEnum<ERichCurveInterpMode>(), InterpMode)));
 }
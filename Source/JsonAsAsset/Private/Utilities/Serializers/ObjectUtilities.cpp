@@ -3,6 +3,7 @@
 #include "Utilities/Serializers/ObjectUtilities.h"
 #include "Utilities/Serializers/PropertyUtilities.h"
 #include "UObject/Package.h"
+#include "Utilities/JsonTypeCache.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogObjectSerializer, All, All);
 PRAGMA_DISABLE_OPTIMIZATION
@@ -49,9 +50,10 @@ UObjectSerializer::UObjectSerializer() {
 	this->LastObjectIndex = 0;
 }
 
-void UObjectSerializer::SetupExports(TArray<TSharedPtr<FJsonValue>> InObjects)
+void UObjectSerializer::SetupExports(const TSharedRef<const FExportIndex>& Index)
 {
-	AllObjectsReference = InObjects;
+	ExportIndex = Index;
+	DeserializedExports.Reset();
 	
 	PropertySerializer->ClearCachedData();
 }
@@ -71,6 +73,24 @@ void UObjectSerializer::SetPropertySerializer(UPropertySerializer* NewPropertySe
 	NewPropertySerializer->ObjectSerializer = this;
 }
 
+void UObjectSerializer::ResetForReuse() {
+	SourcePackage = nullptr;
+	ParentAsset = nullptr;
+	LastObjectIndex = 0;
+
+	ObjectIndices.Reset();
+	LoadedObjects.Reset();
+	SerializedObjects.Reset();
+	ObjectMarks.Reset();
+
+	ExportIndex.Reset();
+	DeserializedExports.Reset();
+	ExportsToNotDeserialize.Reset();
+
+	PropertySerializer->ReferencedObjects.Reset();
+	PropertySerializer->ClearCachedData();
+}
+
 void UObjectSerializer::InitializeForDeserialization(const TArray<TSharedPtr<FJsonValue>>& ObjectsArray) {
 	this->LastObjectIndex = ObjectsArray.Num();
 
@@ -109,7 +129,7 @@ void UObjectSerializer::DeserializeExports(TArray<TSharedPtr<FJsonValue>> Export
 		if (ExportsToNotDeserialize.Contains(Name)) continue;
 
 		FString ClassName = ExportObject->GetStringField(TEXT("Class"));
-		UClass* FoundClass = FindObject<UClass>(ANY_PACKAGE, *ClassName);
+		UClass* FoundClass = FJsonTypeCache::Get().Find<UClass>(ClassName);
 
 		UObject* NewUObject = NewObject<UObject>(ParentAsset, FoundClass, FName(*Name));
 
@@ -417,25 +437,7 @@ void UObjectSerializer::FlushPropertiesIntoObject(const int32 ObjectIndex, UObje
 void UObjectSerializer::DeserializeObjectProperties(const TSharedPtr<FJsonObject>& Properties, UObject* Object) {
 	if (Object == nullptr) return;
 	
-	UClass* ObjectClass = Object->GetClass();
-
-	for (FProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		const FString PropertyName = Property->GetName();
-
-		if (!PropertySerializer->ShouldSerializeProperty(Property)) continue;
-
-		void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
-		bool HasHandledProperty = PassthroughPropertyHandler(Property, PropertyName, PropertyValue, Properties, PropertySerializer);
-
-		if (Properties->HasField(PropertyName) && !HasHandledProperty && PropertyName != "LODParentPrimitive") {
-			const TSharedPtr<FJsonValue>& ValueObject = Properties->Values.FindChecked(PropertyName);
-
-			if (Property->ArrayDim == 1 || ValueObject->Type == EJson::Array)
-			{
-				PropertySerializer->DeserializePropertyValue(Property, ValueObject.ToSharedRef(), PropertyValue);
-			}
-		}
-	}
+	PropertySerializer->DeserializeProperties(Object->GetClass(), Object, Properties, TEXT("LODParentPrimitive"));
 
 	// this is a use case for importing maps and parsing static mesh components
 	// using the object and property serializer, this was initially wanted to be
@@ -0,0 +1,113 @@
+﻿// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/Serializers/PropertyPlan.h"
+
+#include "Utilities/Serializers/PropertyUtilities.h"
+
+#include "Editor.h"
+#include "Kismet2/StructureEditorUtils.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace {
+	/* Plans of Blueprint classes and user defined structs, only valid until one of them changes */
+	TMap<TWeakObjectPtr<const UStruct>, TSharedRef<const FPropertyPlan>> NonNativePlans;
+
+	/* A user defined struct's properties are replaced in place when it's edited */
+	class FUserDefinedStructListener : public FStructureEditorUtils::INotifyOnStructChanged {
+	public:
+		virtual void PreChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override {
+			FPropertyPlan::ForgetNonNative();
+		}
+
+		virtual void PostChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override {
+			FPropertyPlan::ForgetNonNative();
+		}
+	};
+
+	void ListenForChanges() {
+		static bool bListening = false;
+		if (bListening) return;
+
+		bListening = true;
+
+		static FUserDefinedStructListener StructListener;
+
+		FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&) {
+			FPropertyPlan::ForgetNonNative();
+		});
+
+		/* A compiled Blueprint keeps its generated class and relinks its properties */
+		if (GEditor != nullptr) {
+			GEditor->OnBlueprintCompiled().AddStatic(&FPropertyPlan::ForgetNonNative);
+		}
+	}
+}
+
+TSharedRef<const FPropertyPlan> FPropertyPlan::Get(const UStruct* Struct) {
+	check(IsInGameThread());
+
+	/* Native types can't be recompiled or collected */
+	if (!Struct->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn)) {
+		ListenForChanges();
+
+		/* Weak keys of collected types never match again */
+		if (const TSharedRef<const FPropertyPlan>* Plan = NonNativePlans.Find(Struct)) {
+			return *Plan;
+		}
+
+		return NonNativePlans.Add(Struct, MakeShareable(new FPropertyPlan(Struct)));
+	}
+
+	static TMap<const UStruct*, TSharedRef<const FPropertyPlan>> Plans;
+
+	if (const TSharedRef<const FPropertyPlan>* Plan = Plans.Find(Struct)) {
+		return *Plan;
+	}
+
+	return Plans.Add(Struct, MakeShareable(new FPropertyPlan(Struct)));
+}
+
+void FPropertyPlan::ForgetNonNative() {
+	NonNativePlans.Empty();
+}
+
+FPropertyPlan::FPropertyPlan(const UStruct* Struct)
+	: bAllNumbers(true)
+{
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		if (!UPropertySerializer::IsSerializableProperty(Property)) continue;
+
+		const int32 Index = Properties.Add({ Property, Property->GetName(), GetNumberType(Property) });
+
+		if (Properties[Index].Number == EPropertyPlanNumber::None || Properties[Index].IsStaticArray()) {
+			bAllNumbers = false;
+		}
+
+		if (Properties[Index].IsStaticArray()) {
+			StaticArraysByName.Add(Properties[Index].Name, StaticArrays.Add(Index));
+		} else {
+			ByName.Add(Properties[Index].Name, Index);
+		}
+	}
+
+	bAllNumbers = bAllNumbers && Properties.Num() > 0;
+}
+
+EPropertyPlanNumber FPropertyPlan::GetNumberType(const FProperty* Property) {
+	if (Property->IsA<FFloatProperty>()) return EPropertyPlanNumber::Float;
+	if (Property->IsA<FDoubleProperty>()) return EPropertyPlanNumber::Double;
+	if (Property->IsA<FInt8Property>()) return EPropertyPlanNumber::Int8;
+	if (Property->IsA<FInt16Property>()) return EPropertyPlanNumber::Int16;
+	if (Property->IsA<FIntProperty>()) return EPropertyPlanNumber::Int32;
+	if (Property->IsA<FInt64Property>()) return EPropertyPlanNumber::Int64;
+	if (Property->IsA<FUInt16Property>()) return EPropertyPlanNumber::UInt16;
+	if (Property->IsA<FUInt32Property>()) return EPropertyPlanNumber::UInt32;
+	if (Property->IsA<FUInt64Property>()) return EPropertyPlanNumber::UInt64;
+
+	/* Bytes with an enum are written as names */
+	if (const FByteProperty* ByteProperty = CastField<const FByteProperty>(Property)) {
+		return ByteProperty->Enum == nullptr ? EPropertyPlanNumber::UInt8 : EPropertyPlanNumber::None;
+	}
+
+	return EPropertyPlanNumber::None;
+}
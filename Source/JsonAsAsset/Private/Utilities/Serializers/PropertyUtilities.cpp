@@ -5,10 +5,12 @@
 #include "GameplayTagContainer.h"
 #include "Importers/Constructor/Importer.h"
 #include "Utilities/Serializers/ObjectUtilities.h"
+#include "Utilities/Serializers/PropertyPlan.h"
+#include "Utilities/JsonReferenceCache.h"
+#include "Utilities/JsonEnumCache.h"
 #include "UObject/TextProperty.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogPropertySerializer, Error, Log);
-PRAGMA_DISABLE_OPTIMIZATION
 
 void FDateTimeSerializer::Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) {
 	const FDateTime* DateTime = (const FDateTime*)StructData;
@@ -60,24 +62,7 @@ void FFallbackStructSerializer::Serialize(UScriptStruct* Struct, const TSharedPt
 }
 
 void FFallbackStructSerializer::Deserialize(UScriptStruct* Struct, void* StructData, const TSharedPtr<FJsonObject> JsonValue) {
-	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		const FString PropertyName = Property->GetName();
-
-		if (PropertySerializer->ShouldSerializeProperty(Property)) {
-			void* PropertyValue = Property->ContainerPtrToValuePtr<void>(StructData);
-
-			bool HasHandledProperty = PassthroughPropertyHandler(Property, PropertyName, PropertyValue, JsonValue, PropertySerializer);
-
-			if (!HasHandledProperty && JsonValue->HasField(PropertyName)) {
-				const TSharedPtr<FJsonValue> ValueObject = JsonValue->Values.FindChecked(PropertyName);
-
-				if (Property->ArrayDim == 1 || ValueObject->Type == EJson::Array)
-				{
-					PropertySerializer->DeserializePropertyValue(Property, ValueObject.ToSharedRef(), PropertyValue);
-				}
-			}
-		}
-	}
+	PropertySerializer->DeserializeProperties(Struct, StructData, JsonValue);
 }
 
 bool FFallbackStructSerializer::Compare(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, const TSharedPtr<FObjectCompareContext> Context) {
@@ -169,11 +154,37 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = NewJsonValue->AsArray();
 		ArrayHelper.EmptyValues();
 
+		if (SetArray.Num() == 0) return;
+
+		// Sized once, every element is initialized like AddValue would
+		ArrayHelper.AddValues(SetArray.Num());
+
+		// Curves, mesh and Niagara data are mostly arrays of plain numbers
+		const EPropertyPlanNumber ElementNumber = FPropertyPlan::GetNumberType(ElementProperty);
+
+		if (ElementNumber != EPropertyPlanNumber::None) {
+			DeserializeNumberArray(ElementNumber, SetArray, ArrayHelper.GetRawPtr(0));
+			return;
+		}
+
+		// Or of vectors and colors, structs made of numbers only
+		const FStructProperty* ElementStructProperty = CastField<const FStructProperty>(ElementProperty);
+		TSharedPtr<const FPropertyPlan> ElementPlan;
+
+		if (ElementStructProperty != nullptr && BlacklistedProperties.Num() == 0 && GetStructSerializer(ElementStructProperty->Struct) == FallbackStructSerializer.Get()) {
+			ElementPlan = FPropertyPlan::Get(ElementStructProperty->Struct);
+			if (!ElementPlan->IsAllNumbers()) ElementPlan.Reset();
+		}
+
 		for (int32 i = 0; i < SetArray.Num(); i++) {
 			const TSharedPtr<FJsonValue>& Element = SetArray[i];
-			const uint32 AddedIndex = ArrayHelper.AddValue();
-			uint8* ValuePtr = ArrayHelper.GetRawPtr(AddedIndex);
-			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), ValuePtr);
+			uint8* ValuePtr = ArrayHelper.GetRawPtr(i);
+
+			if (ElementPlan.IsValid() && Element->Type == EJson::Object) {
+				DeserializeNumberStruct(*ElementPlan, *Element->AsObject(), ValuePtr);
+			} else {
+				DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), ValuePtr);
+			}
 		}
 	}
 	else if (Property->IsA<FMulticastDelegateProperty>()) {
@@ -213,10 +224,9 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			FSoftObjectPtr* ObjectPtr = static_cast<FSoftObjectPtr*>(Value);
 			*ObjectPtr = FSoftObjectPath(PathString);
 
-			if (!ObjectPtr->LoadSynchronous())
+			if (FJsonReferenceCache::Get().Load(PathString) == nullptr)
 			{
 				// Try importing it using Local Fetch
-				IImporter* Importer = new IImporter();
 				FString PackagePath;
 				FString AssetName;
 				PathString.Split(".", &PackagePath, &AssetName);
@@ -224,7 +234,7 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 
 				FString PropertyClassName = SoftObjectProperty->PropertyClass->GetName();
 				
-				Importer->DownloadWrapper(T, PropertyClassName, AssetName, PackagePath);
+				IImporter::DownloadWrapper(T, PropertyClassName, AssetName, PackagePath);
 			}
 		}
 	}
@@ -237,11 +247,8 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 
 		if (bUseDefaultLoadObject)
 		{
-			// Use IImporter to import the object
-			IImporter* Importer = new IImporter();
-
-			Importer->ParentObject = ObjectSerializer->ParentAsset;
-			Importer->LoadObject(&JsonValueAsObject, Object);
+			// Resolved like IImporter::LoadObject, through the session's reference cache
+			Object = IImporter::ResolveObject<UObject>(*JsonValueAsObject, ObjectSerializer->ParentAsset);
 
 			if (Object == nullptr)
 			{
@@ -266,11 +273,15 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 				ObjectProperty->SetObjectPropertyValue(Value, Object);
 			}
 
-			if (Object != nullptr) {
+			// Subobjects exported in the same file get their properties, assets are imported on their own
+			if (Object != nullptr && !Object->IsAsset() && ObjectSerializer->ExportIndex.IsValid()) {
 				// Get the export
-				if (TSharedPtr<FJsonObject> Export = GetExport(JsonValueAsObject.Get(), ObjectSerializer->AllObjectsReference))
+				if (TSharedPtr<FJsonObject> Export = GetExport(JsonValueAsObject.Get(), *ObjectSerializer->ExportIndex))
 				{
-					if (Export->HasField(TEXT("Properties")))
+					bool bAlreadyDeserialized = false;
+					ObjectSerializer->DeserializedExports.Add(Export.Get(), &bAlreadyDeserialized);
+
+					if (!bAlreadyDeserialized && Export->HasField(TEXT("Properties")))
 					{
 						TSharedPtr<FJsonObject> Properties = Export->GetObjectField(TEXT("Properties"));
 
@@ -350,10 +361,9 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 				FSoftObjectPtr* ObjectPtr = static_cast<FSoftObjectPtr*>(Value);
 				*ObjectPtr = FSoftObjectPath(PathString);
 
-				if (!ObjectPtr->LoadSynchronous())
+				if (FJsonReferenceCache::Get().Load(PathString) == nullptr)
 				{
 					// Try importing it using Local Fetch
-					IImporter* Importer = new IImporter();
 					FString PackagePath;
 					FString AssetName;
 					PathString.Split(".", &PackagePath, &AssetName);
@@ -361,7 +371,7 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 
 					FString PropertyClassName = "DataAsset";
 				
-					Importer->DownloadWrapper(T, PropertyClassName, AssetName, PackagePath);
+					IImporter::DownloadWrapper(T, PropertyClassName, AssetName, PackagePath);
 				}
 			}
 		}
@@ -389,7 +399,7 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			FString EnumAsString = JsonValue->AsString();
 
 			check(ByteProperty->Enum);
-			int64 EnumerationValue = ByteProperty->Enum->GetValueByNameString(EnumAsString);
+			int64 EnumerationValue = FJsonEnumCache::Get().GetValue(ByteProperty->Enum, EnumAsString);
 
 			ByteProperty->SetIntPropertyValue(Value, EnumerationValue);
 		}
@@ -418,7 +428,7 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		const FString EnumAsString = NewJsonValue->AsString();
 
 		// Prefer readable enum names in result json to raw numbers
-		int64 EnumerationValue = EnumProperty->GetEnum()->GetValueByNameString(EnumAsString);
+		int64 EnumerationValue = FJsonEnumCache::Get().GetValue(EnumProperty->GetEnum(), EnumAsString);
 		
 		if (ensure(EnumerationValue != INDEX_NONE)) {
 			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, EnumerationValue);
@@ -473,7 +483,102 @@ void UPropertySerializer::AddStructSerializer(UScriptStruct* Struct, const TShar
 	this->StructSerializers.Add(Struct, Serializer);
 }
 
-bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
+void UPropertySerializer::DeserializeProperties(const UStruct* Struct, void* Container, const TSharedPtr<FJsonObject>& Properties, const FName IgnoredProperty) {
+	const TSharedRef<const FPropertyPlan> PlanRef = FPropertyPlan::Get(Struct);
+	const FPropertyPlan& Plan = *PlanRef;
+	const bool bHasBlacklist = BlacklistedProperties.Num() > 0;
+
+	const TArray<int32>& StaticArrays = Plan.GetStaticArrays();
+
+	// Elements of each static array, from its PropertyName[Index] keys
+	TArray<TArray<TSharedPtr<FJsonValue>>> StaticArrayElements;
+	StaticArrayElements.SetNum(StaticArrays.Num());
+
+	FString StaticArrayName;
+	int32 StaticArrayIndex;
+
+	// Only the keys that are there, most properties of a struct usually aren't
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Properties->Values) {
+		if (const FPropertyPlanEntry* Entry = Plan.Find(Pair.Key)) {
+			if (Entry->Property->GetFName() == IgnoredProperty) continue;
+			if (bHasBlacklist && BlacklistedProperties.Contains(Entry->Property)) continue;
+
+			void* PropertyValue = Entry->Property->ContainerPtrToValuePtr<void>(Container);
+			DeserializePropertyValue(Entry->Property, Pair.Value.ToSharedRef(), PropertyValue);
+
+			continue;
+		}
+
+		if (StaticArrays.Num() == 0) continue;
+
+		SplitStaticArrayKey(Pair.Key, StaticArrayName, StaticArrayIndex);
+
+		const int32 Slot = Plan.FindStaticArray(StaticArrayName);
+		if (Slot == INDEX_NONE || StaticArrayIndex < 0) continue;
+
+		const FProperty* Property = Plan.GetProperties()[StaticArrays[Slot]].Property;
+		if (StaticArrayIndex >= Property->ArrayDim) continue;
+
+		TArray<TSharedPtr<FJsonValue>>& Elements = StaticArrayElements[Slot];
+
+		if (StaticArrayIndex >= Elements.Num()) {
+			Elements.SetNum(StaticArrayIndex + 1);
+		}
+
+		Elements[StaticArrayIndex] = Pair.Value;
+	}
+
+	for (int32 Slot = 0; Slot < StaticArrays.Num(); Slot++) {
+		const FPropertyPlanEntry& Entry = Plan.GetProperties()[StaticArrays[Slot]];
+		if (StaticArrayElements[Slot].Num() == 0) continue;
+		if (bHasBlacklist && BlacklistedProperties.Contains(Entry.Property)) continue;
+
+		void* PropertyValue = Entry.Property->ContainerPtrToValuePtr<void>(Container);
+		DeserializeStaticArray(Entry.Property, StaticArrayElements[Slot], PropertyValue, this);
+	}
+}
+
+template <typename T>
+static void DeserializeNumbers(const TArray<TSharedPtr<FJsonValue>>& Elements, void* Data) {
+	T* Values = static_cast<T*>(Data);
+	double Number;
+
+	for (int32 Index = 0; Index < Elements.Num(); Index++) {
+		if (!Elements[Index]->TryGetNumber(Number)) continue;
+
+		// Integers go through int64 like SetIntPropertyValue
+		Values[Index] = std::is_floating_point<T>::value ? static_cast<T>(Number) : static_cast<T>(static_cast<int64>(Number));
+	}
+}
+
+void UPropertySerializer::DeserializeNumberArray(const EPropertyPlanNumber Type, const TArray<TSharedPtr<FJsonValue>>& Elements, void* Data) {
+	switch (Type) {
+		case EPropertyPlanNumber::Float: DeserializeNumbers<float>(Elements, Data); break;
+		case EPropertyPlanNumber::Double: DeserializeNumbers<double>(Elements, Data); break;
+		case EPropertyPlanNumber::Int8: DeserializeNumbers<int8>(Elements, Data); break;
+		case EPropertyPlanNumber::Int16: DeserializeNumbers<int16>(Elements, Data); break;
+		case EPropertyPlanNumber::Int32: DeserializeNumbers<int32>(Elements, Data); break;
+		case EPropertyPlanNumber::Int64: DeserializeNumbers<int64>(Elements, Data); break;
+		case EPropertyPlanNumber::UInt8: DeserializeNumbers<uint8>(Elements, Data); break;
+		case EPropertyPlanNumber::UInt16: DeserializeNumbers<uint16>(Elements, Data); break;
+		case EPropertyPlanNumber::UInt32: DeserializeNumbers<uint32>(Elements, Data); break;
+		case EPropertyPlanNumber::UInt64: DeserializeNumbers<uint64>(Elements, Data); break;
+		default: break;
+	}
+}
+
+void UPropertySerializer::DeserializeNumberStruct(const FPropertyPlan& Plan, const FJsonObject& Object, void* StructData) {
+	double Number;
+
+	for (const FPropertyPlanEntry& Entry : Plan.GetProperties()) {
+		const TSharedPtr<FJsonValue>* Value = Object.Values.Find(Entry.Name);
+		if (Value == nullptr || !(*Value)->TryGetNumber(Number)) continue;
+
+		FPropertyPlan::SetNumber(Entry.Number, Entry.Property->ContainerPtrToValuePtr<void>(StructData), Number);
+	}
+}
+
+bool UPropertySerializer::IsSerializableProperty(const FProperty* Property) {
 	// Skip transient properties
 	if (Property->HasAnyPropertyFlags(CPF_Transient)) {
 		return true;
@@ -483,7 +588,11 @@ bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
 		return true;
 	}
 	// Skip deprecated properties
-	if (Property->HasAnyPropertyFlags(CPF_Deprecated)) {
+	return !Property->HasAnyPropertyFlags(CPF_Deprecated);
+}
+
+bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
+	if (!IsSerializableProperty(Property)) {
 		return false;
 	}
 	if (this == nullptr) {
@@ -833,5 +942,3 @@ FStructSerializer* UPropertySerializer::GetStructSerializer(UScriptStruct* Struc
 	TSharedPtr<FStructSerializer> const* StructSerializer = StructSerializers.Find(Struct);
 	return StructSerializer && ensure(StructSerializer->IsValid()) ? StructSerializer->Get() : FallbackStructSerializer.Get();
 }
-
-PRAGMA_ENABLE_OPTIMIZATION
\ No newline at end of file
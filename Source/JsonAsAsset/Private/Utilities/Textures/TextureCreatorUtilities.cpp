@@ -3,6 +3,7 @@
 #include "Utilities/Textures/TextureCreatorUtilities.h"
 
 #include "detex.h"
+#include "Async/ParallelFor.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/TextureCube.h"
 #include "Engine/VolumeTexture.h"
@@ -10,8 +11,10 @@
 #include "nvimage/DirectDrawSurface.h"
 #include "nvimage/Image.h"
 #include "Utilities/EngineUtilities.h"
+#include "Utilities/JsonEnumCache.h"
 #include "Utilities/MathUtilities.h"
 #include "Utilities/Textures/TextureDecode/TextureNVTT.h"
+#include "UObject/GCObjectScopeGuard.h"
 
 bool FTextureCreatorUtilities::CreateTexture2D(UTexture*& OutTexture2D, TArray<uint8>& Data, const TSharedPtr<FJsonObject>& Properties) const {
 	const TSharedPtr<FJsonObject> SubObjectProperties = Properties->GetObjectField(TEXT("Properties"));
@@ -46,7 +49,7 @@ bool FTextureCreatorUtilities::CreateTexture2D(UTexture*& OutTexture2D, TArray<u
 	}
 
 	FString PixelFormat;
-	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(Texture2D->GetPixelFormatEnum()->GetValueByNameString(PixelFormat));
+	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(FJsonEnumCache::Get().GetValue(Texture2D->GetPixelFormatEnum(), PixelFormat));
 
 	int Size = SizeX * SizeY * (PlatformData->PixelFormat == PF_BC6H ? 16 : 4);
 	if (PlatformData->PixelFormat == PF_B8G8R8A8 || PlatformData->PixelFormat == PF_FloatRGBA || PlatformData->PixelFormat == PF_G16) Size = Data.Num();
@@ -94,7 +97,7 @@ bool FTextureCreatorUtilities::CreateTextureCube(UTexture*& OutTextureCube, cons
 	const int SizeY = Properties->GetNumberField(TEXT("SizeY")) / 6;
 
 	FString PixelFormat;
-	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(TextureCube->GetPixelFormatEnum()->GetValueByNameString(PixelFormat));
+	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(FJsonEnumCache::Get().GetValue(TextureCube->GetPixelFormatEnum(), PixelFormat));
 
 	int Size = SizeX * SizeY * (PlatformData->PixelFormat == PF_BC6H ? 16 : 4);
 	if (PlatformData->PixelFormat == PF_FloatRGBA) Size = Data.Num();
@@ -132,7 +135,7 @@ bool FTextureCreatorUtilities::CreateVolumeTexture(UTexture*& OutVolumeTexture,
 #endif
 	
 	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat))
-		PlatformData->PixelFormat = static_cast<EPixelFormat>(VolumeTexture->GetPixelFormatEnum()->GetValueByNameString(PixelFormat));
+		PlatformData->PixelFormat = static_cast<EPixelFormat>(FJsonEnumCache::Get().GetValue(VolumeTexture->GetPixelFormatEnum(), PixelFormat));
 
 	DeserializeTexture(VolumeTexture, Properties);
 
@@ -163,7 +166,9 @@ bool FTextureCreatorUtilities::CreateVolumeTexture(UTexture*& OutVolumeTexture,
 
 bool FTextureCreatorUtilities::CreateRenderTarget2D(UTexture*& OutRenderTarget2D, const TSharedPtr<FJsonObject>& Properties) const {
 	UTextureRenderTargetFactoryNew* TextureFactory = NewObject<UTextureRenderTargetFactoryNew>();
-	TextureFactory->AddToRoot();
+
+	/* Only needed while it creates the render target, collectable again right after */
+	FGCObjectScopeGuard FactoryGuard(TextureFactory);
 	UTextureRenderTarget2D* RenderTarget2D = Cast<UTextureRenderTarget2D>(TextureFactory->FactoryCreateNew(UTextureRenderTarget2D::StaticClass(), OutermostPkg, *FileName, RF_Standalone | RF_Public, nullptr, GWarn));
 
 	DeserializeTexture(RenderTarget2D, Properties);
@@ -174,11 +179,11 @@ bool FTextureCreatorUtilities::CreateRenderTarget2D(UTexture*& OutRenderTarget2D
 	if (Properties->TryGetNumberField(TEXT("SizeY"), SizeY)) RenderTarget2D->SizeY = SizeY;
 
 	FString AddressX;
-	if (Properties->TryGetStringField(TEXT("AddressX"), AddressX)) RenderTarget2D->AddressX = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressX));
+	if (Properties->TryGetStringField(TEXT("AddressX"), AddressX)) RenderTarget2D->AddressX = static_cast<TextureAddress>(FJsonEnumCache::Get().GetValue(StaticEnum<TextureAddress>(), AddressX));
 	FString AddressY;
-	if (Properties->TryGetStringField(TEXT("AddressY"), AddressY)) RenderTarget2D->AddressY = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressY));
+	if (Properties->TryGetStringField(TEXT("AddressY"), AddressY)) RenderTarget2D->AddressY = static_cast<TextureAddress>(FJsonEnumCache::Get().GetValue(StaticEnum<TextureAddress>(), AddressY));
 	FString RenderTargetFormat;
-	if (Properties->TryGetStringField(TEXT("RenderTargetFormat"), RenderTargetFormat)) RenderTarget2D->RenderTargetFormat = static_cast<ETextureRenderTargetFormat>(StaticEnum<ETextureRenderTargetFormat>()->GetValueByNameString(RenderTargetFormat));
+	if (Properties->TryGetStringField(TEXT("RenderTargetFormat"), RenderTargetFormat)) RenderTarget2D->RenderTargetFormat = static_cast<ETextureRenderTargetFormat>(FJsonEnumCache::Get().GetValue(StaticEnum<ETextureRenderTargetFormat>(), RenderTargetFormat));
 
 	bool bAutoGenerateMips;
 	if (Properties->TryGetBoolField(TEXT("bAutoGenerateMips"), bAutoGenerateMips)) RenderTarget2D->bAutoGenerateMips = bAutoGenerateMips;
@@ -186,7 +191,7 @@ bool FTextureCreatorUtilities::CreateRenderTarget2D(UTexture*& OutRenderTarget2D
 		FString MipsSamplerFilter;
 		
 		if (Properties->TryGetStringField(TEXT("MipsSamplerFilter"), MipsSamplerFilter))
-			RenderTarget2D->MipsSamplerFilter = static_cast<TextureFilter>(StaticEnum<TextureFilter>()->GetValueByNameString(MipsSamplerFilter));
+			RenderTarget2D->MipsSamplerFilter = static_cast<TextureFilter>(FJsonEnumCache::Get().GetValue(StaticEnum<TextureFilter>(), MipsSamplerFilter));
 	}
 
 	const TSharedPtr<FJsonObject>* ClearColor;
@@ -209,8 +214,8 @@ bool FTextureCreatorUtilities::DeserializeTexture2D(UTexture2D* InTexture2D, con
 	FString AddressY;
 	bool bHasBeenPaintedInEditor;
 
-	if (Properties->TryGetStringField(TEXT("AddressX"), AddressX)) InTexture2D->AddressX = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressX));
-	if (Properties->TryGetStringField(TEXT("AddressY"), AddressY)) InTexture2D->AddressY = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressY));
+	if (Properties->TryGetStringField(TEXT("AddressX"), AddressX)) InTexture2D->AddressX = static_cast<TextureAddress>(FJsonEnumCache::Get().GetValue(StaticEnum<TextureAddress>(), AddressX));
+	if (Properties->TryGetStringField(TEXT("AddressY"), AddressY)) InTexture2D->AddressY = static_cast<TextureAddress>(FJsonEnumCache::Get().GetValue(StaticEnum<TextureAddress>(), AddressY));
 	if (Properties->TryGetBoolField(TEXT("bHasBeenPaintedInEditor"), bHasBeenPaintedInEditor)) InTexture2D->bHasBeenPaintedInEditor = bHasBeenPaintedInEditor;
 
 	// --------- Platform Data --------- //
@@ -227,7 +232,7 @@ bool FTextureCreatorUtilities::DeserializeTexture2D(UTexture2D* InTexture2D, con
 	if (Properties->TryGetNumberField(TEXT("SizeX"), SizeX)) PlatformData->SizeX = SizeX;
 	if (Properties->TryGetNumberField(TEXT("SizeY"), SizeY)) PlatformData->SizeY = SizeY;
 	if (Properties->TryGetNumberField(TEXT("PackedData"), PackedData)) PlatformData->PackedData = PackedData;
-	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(InTexture2D->GetPixelFormatEnum()->GetValueByNameString(PixelFormat));
+	if (Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(FJsonEnumCache::Get().GetValue(InTexture2D->GetPixelFormatEnum(), PixelFormat));
 
 	int FirstResourceMemMip;
 	int LevelIndex;
@@ -250,52 +255,125 @@ bool FTextureCreatorUtilities::DeserializeTexture(UTexture* Texture, const TShar
 	return false;
 }
 
+void FTextureCreatorUtilities::DecompressTextureParallel(const uint8* Data, uint8* OutData, const int SizeX, const int SizeY, const uint32 TextureFormat, const uint32 PixelFormat, const int BlockSizeX, const int BlockSizeY)
+{
+	const bool bIsASTC = detexGetCompressedFormat(TextureFormat) == DETEX_COMPRESSED_TEXTURE_FORMAT_INDEX_ASTC_4X4;
+	const int WidthInBlocks = FMath::DivideAndRoundUp(SizeX, BlockSizeX);
+	const int HeightInBlocks = FMath::DivideAndRoundUp(SizeY, BlockSizeY);
+	const int BlockRowBytes = WidthInBlocks * detexGetCompressedBlockSize(TextureFormat);
+	const int PixelRowBytes = SizeX * detexGetPixelSize(PixelFormat);
+
+	/* Each task decodes a band of block rows, which maps to a contiguous range of output rows */
+	constexpr int BlockRowsPerTask = 16;
+	const int NumTasks = FMath::DivideAndRoundUp(HeightInBlocks, BlockRowsPerTask);
+
+	ParallelFor(NumTasks, [&](const int32 TaskIndex) {
+		const int FirstBlockRow = TaskIndex * BlockRowsPerTask;
+		const int NumBlockRows = FMath::Min(BlockRowsPerTask, HeightInBlocks - FirstBlockRow);
+
+		detexTexture Band;
+		Band.format = TextureFormat;
+		Band.data = const_cast<uint8*>(Data) + FirstBlockRow * BlockRowBytes;
+		Band.width = SizeX;
+		Band.height = FMath::Min(SizeY - FirstBlockRow * BlockSizeY, NumBlockRows * BlockSizeY);
+		Band.width_in_blocks = WidthInBlocks;
+		Band.height_in_blocks = NumBlockRows;
+
+		uint8* BandOutData = OutData + FirstBlockRow * BlockSizeY * PixelRowBytes;
+
+		if (bIsASTC) {
+			detexDecompressTextureLinearASTC(&Band, BlockSizeX, BlockSizeY, BandOutData, PixelFormat);
+		} else {
+			detexDecompressTextureLinear(&Band, BandOutData, PixelFormat);
+		}
+	});
+}
+
 void FTextureCreatorUtilities::GetDecompressedTextureData(uint8* Data, uint8*& OutData, const int SizeX, const int SizeY, const int SizeZ, const int TotalSize, const EPixelFormat Format)
 {
 	// NOTE: Not all formats are supported, feel free to add
 	//       if needed. Formats may need other dependencies.
 	switch (Format) {
-	case PF_BC7: {
-		detexTexture Texture;
-		Texture.data = Data;
-		Texture.format = DETEX_TEXTURE_FORMAT_BPTC;
-		Texture.width = SizeX;
-		Texture.height = SizeY;
-		Texture.width_in_blocks = SizeX / 4;
-		Texture.height_in_blocks = SizeY / 4;
-
-		detexDecompressTextureLinear(&Texture, OutData, DETEX_PIXEL_FORMAT_BGRA8);
-	}
-	break;
+	case PF_BC7:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_BPTC, DETEX_PIXEL_FORMAT_BGRA8);
+		break;
 
-	case PF_BC6H: {
-		detexTexture Texture;
-		Texture.data = Data;
-		Texture.format = DETEX_TEXTURE_FORMAT_BPTC_FLOAT;
-		Texture.width = SizeX;
-		Texture.height = SizeY;
-		Texture.width_in_blocks = SizeX / 4;
-		Texture.height_in_blocks = SizeY / 4;
+	case PF_BC6H:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_BPTC_FLOAT, DETEX_PIXEL_FORMAT_BGRA8);
+		break;
 
-		detexDecompressTextureLinear(&Texture, OutData, DETEX_PIXEL_FORMAT_BGRA8);
+	case PF_DXT5:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_BC3, DETEX_PIXEL_FORMAT_BGRA8);
+		break;
+
+	/* Mobile (Android) cooked formats */
+	case PF_ETC2_RGB:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ETC2, DETEX_PIXEL_FORMAT_BGRA8);
+		break;
+
+	case PF_ETC2_RGBA:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ETC2_EAC, DETEX_PIXEL_FORMAT_BGRA8);
+		break;
+
+	/* Single channel EAC, replicated to RGB like G8 */
+	case PF_ETC2_R11_EAC: {
+		TArray<uint16> Decoded;
+		Decoded.SetNumUninitialized(SizeX * SizeY);
+		DecompressTextureParallel(Data, reinterpret_cast<uint8*>(Decoded.GetData()), SizeX, SizeY, DETEX_TEXTURE_FORMAT_EAC_R11, DETEX_PIXEL_FORMAT_R16);
+
+		uint8* d = OutData;
+
+		for (const uint16 Value : Decoded) {
+			const uint8 r = Value >> 8;
+			*d++ = r;
+			*d++ = r;
+			*d++ = r;
+			*d++ = 255;
+		}
 	}
 	break;
 
-	case PF_DXT5: {
-		detexTexture Texture;
-		{
-			Texture.data = Data;
-			Texture.format = DETEX_TEXTURE_FORMAT_BC3;
-			Texture.width = SizeX;
-			Texture.height = SizeY;
-			Texture.width_in_blocks = SizeX / 4;
-			Texture.height_in_blocks = SizeY / 4;
-		}
+	/* Two channel EAC (normal maps), blue is reconstructed like BC5 */
+	case PF_ETC2_RG11_EAC: {
+		TArray<uint16> Decoded;
+		Decoded.SetNumUninitialized(SizeX * SizeY * 2);
+		DecompressTextureParallel(Data, reinterpret_cast<uint8*>(Decoded.GetData()), SizeX, SizeY, DETEX_TEXTURE_FORMAT_EAC_RG11, DETEX_PIXEL_FORMAT_RG16);
+
+		uint8* d = OutData;
+
+		for (int i = 0; i < SizeX * SizeY; i++) {
+			const float X = Decoded[i * 2] / 32767.5f - 1.0f;
+			const float Y = Decoded[i * 2 + 1] / 32767.5f - 1.0f;
+			const float Z = FMath::Sqrt(FMath::Max(0.0f, 1.0f - X * X - Y * Y));
 
-		detexDecompressTextureLinear(&Texture, OutData, DETEX_PIXEL_FORMAT_BGRA8);
+			*d++ = static_cast<uint8>(FMath::RoundToInt((Z + 1.0f) * 127.5f));
+			*d++ = Decoded[i * 2 + 1] >> 8;
+			*d++ = Decoded[i * 2] >> 8;
+			*d++ = 255;
+		}
 	}
 	break;
 
+	case PF_ASTC_4x4:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ASTC_4X4, DETEX_PIXEL_FORMAT_BGRA8, 4, 4);
+		break;
+
+	case PF_ASTC_6x6:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ASTC_4X4, DETEX_PIXEL_FORMAT_BGRA8, 6, 6);
+		break;
+
+	case PF_ASTC_8x8:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ASTC_4X4, DETEX_PIXEL_FORMAT_BGRA8, 8, 8);
+		break;
+
+	case PF_ASTC_10x10:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ASTC_4X4, DETEX_PIXEL_FORMAT_BGRA8, 10, 10);
+		break;
+
+	case PF_ASTC_12x12:
+		DecompressTextureParallel(Data, OutData, SizeX, SizeY, DETEX_TEXTURE_FORMAT_ASTC_4X4, DETEX_PIXEL_FORMAT_BGRA8, 12, 12);
+		break;
+
 	// Gray/Grey, not Green, typically actually uses a red format with replication of R to RGB
 	case PF_G8: {
 		const uint8* s = Data;
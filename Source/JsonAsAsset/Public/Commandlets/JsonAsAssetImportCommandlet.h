@@ -0,0 +1,37 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "JsonAsAssetImportCommandlet.generated.h"
+
+/*
+ * Imports a directory of exports without the editor UI, for overnight or CI ports:
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=JsonAsAssetImport -Dir=<Directory>
+ *       [-ExportDirectory=<Directory>] [-Threads=N] [-Workers=N] [-Report=<File>] [-NoSave]
+ *
+ * Files are imported in dependency order like "Import Folder", with N files parsing ahead on
+ * workers. Packages are saved together after each wave, and saved assets are unloaded every 500
+ * files unless JsonAsAsset.GCBetweenWaves says otherwise. A JSON report of every file (result
+ * and time taken) and every package (save time) is written to Saved/JsonAsAsset/ImportReport.json
+ * unless -Report says otherwise. Returns 0 when every file was imported and saved.
+ *
+ * With -Workers the commandlet only coordinates. It starts N editor processes once (run with
+ * -WorkerDir=<Directory>), splits each dependency wave into one shard per worker and waits for
+ * them all before handing out the next wave, so later waves load what earlier ones saved. Export
+ * files outside -Dir that the directory references are imported in an earlier wave too, and
+ * workers never import or download a missing reference themselves.
+ *
+ * -FileList=<File> imports the listed files in the order given, as a single wave.
+ */
+UCLASS()
+class UJsonAsAssetImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJsonAsAssetImportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,88 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Dom/JsonValue.h"
+
+struct FExportIndex;
+
+/* Everything about an export file that can be worked out without touching a UObject */
+struct FJsonImportPlan {
+	/* Full path of the file */
+	FString File;
+
+	bool bParsed = false;
+	FString Error;
+
+	TArray<TSharedPtr<FJsonValue>> Exports;
+
+	/* Type and Name of each export, in the same order */
+	TArray<FString> Types;
+	TArray<FString> Names;
+
+	/* Name/Outer/Type lookups over Exports, shared by every importer of the file */
+	TSharedPtr<const FExportIndex> ExportIndex;
+
+	/* Export files this one references, found through the export manifest */
+	TArray<FString> References;
+};
+
+/*
+ * Reads and parses export files on worker threads so the game thread only has to construct.
+ *
+ * Files passed to Prepare are parsed in the background, along with the files they reference.
+ * IImporter::ImportReference then takes the finished plan instead of reading the file itself,
+ * files nobody prepared are parsed on the spot like before.
+ */
+class JSONASASSET_API FJsonImportPipeline {
+public:
+	static FJsonImportPipeline& Get();
+
+	/* Starts parsing Files, and the files they reference when bPrefetchReferences is set */
+	void Prepare(const TArray<FString>& Files, bool bPrefetchReferences = true);
+
+	/* Plan of a file, waiting for it if it's still being parsed and parsing it here if it was never prepared */
+	TSharedRef<const FJsonImportPlan> TakePlan(const FString& File);
+
+	/* Plan of a file without taking it, so importing it later doesn't parse it again */
+	TSharedRef<const FJsonImportPlan> PeekPlan(const FString& File);
+
+	/* Files referenced by others in the list come first, the list's order is kept otherwise (and for cycles) */
+	TArray<FString> SortByDependencies(const TArray<FString>& Files);
+
+	/*
+	 * Splits Files into waves, each file only referencing files of earlier waves. Files are
+	 * parsed into arenas in parallel for their references and nothing else is kept, files in a
+	 * cycle share the last wave. MaxConcurrency limits how many files are parsed at once, 0 for no limit.
+	 * OutReferences receives the export files each of Files references, in the same order.
+	 */
+	static TArray<TArray<FString>> SortIntoWaves(const TArray<FString>& Files, int32 MaxConcurrency = 0, TArray<TArray<FString>>* OutReferences = nullptr);
+
+	/* Same, with the references of each of Files already known */
+	static TArray<TArray<FString>> SortIntoWaves(const TArray<FString>& Files, const TArray<TArray<FString>>& References);
+
+	/*
+	 * Export files each of Files references, in the same order, parsed like SortIntoWaves does.
+	 * OnProgress is called on this thread after every MaxConcurrency files with how many were
+	 * scanned so far, returning false stops the scan and leaves the rest without references.
+	 */
+	static TArray<TArray<FString>> FindReferences(const TArray<FString>& Files, int32 MaxConcurrency = 0, const TFunction<bool(int32 NumScanned)>& OnProgress = nullptr);
+
+	/* Drops the plans nobody took, waiting for those still being parsed */
+	void Reset();
+
+	/* Full path with forward slashes, how plans and references name files */
+	static FString NormalizePath(const FString& File);
+
+private:
+	void Launch(const FString& File, const FString& ExportDirectory, bool bPrefetchReferences);
+
+	static TArray<TArray<int32>> SortIndicesIntoWaves(const TArray<FString>& Files, const TArray<TArray<FString>>& References);
+
+	static TSharedPtr<const FJsonImportPlan> BuildPlan(const FString& File, const FString& ExportDirectory);
+
+	FCriticalSection Mutex;
+	TMap<FString, TSharedFuture<TSharedPtr<const FJsonImportPlan>>> Pending;
+};
@@ -25,17 +25,30 @@ public:
               const TSharedPtr<FJsonObject>& JsonObject, UPackage* Package, 
               UPackage* OutermostPkg, const TArray<TSharedPtr<FJsonValue>>& AllJsonObjects = {});
 
-    virtual ~IImporter() {}
+    /* Importers own pooled serializers, copying one would release them twice */
+    IImporter(const IImporter&) = delete;
+    IImporter& operator=(const IImporter&) = delete;
+
+    virtual ~IImporter();
 
 protected:
     /* Class variables ------------------------------------------------------------------ */
     TArray<TSharedPtr<FJsonValue>> AllJsonObjects;
+
     TSharedPtr<FJsonObject> JsonObject;
     FString FileName;
     FString FilePath;
     UPackage* Package;
     UPackage* OutermostPkg;
 
+    /* Lookups over the exports of the file, shared by every importer of it */
+    const FExportIndex& GetExportIndex() const;
+
+private:
+    /* Set by ImportExports, built from AllJsonObjects on first use otherwise */
+    mutable TSharedPtr<const FExportIndex> ExportIndex;
+
+protected:
     /* ----------------------------------------------------------------------------------- */
     
 public:
@@ -75,11 +88,18 @@ public:
     template<class T = UObject>
     TArray<TObjectPtr<T>> LoadObject(const TArray<TSharedPtr<FJsonValue>>& PackageArray, TArray<TObjectPtr<T>> Array);
 
+    /* What LoadObject does, for callers without an importer of their own like the property serializer */
+    template<class T = UObject>
+    static TObjectPtr<T> ResolveObject(const FJsonObject& PackageIndex, UObject* Parent = nullptr);
+
     /* LoadObject functions ---------------------------------------------------------------------- */
 public:
-    void ImportReference(const FString& File) const;
+    bool ImportReference(const FString& File) const;
     bool ImportAssetReference(const FString& GamePath) const;
-    bool ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString File, bool bHideNotifications = false) const;
+    bool ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString File, bool bHideNotifications = false, TSharedPtr<const FExportIndex> Index = nullptr) const;
+
+    /* Shares an index of the file's exports instead of building one per importer */
+    void SetExportIndex(const TSharedRef<const FExportIndex>& Index);
 
 public:
     TArray<TSharedPtr<FJsonValue>> GetObjectsWithTypeStartingWith(const FString& StartsWithStr);
@@ -105,7 +125,7 @@ public:
     FORCEINLINE UObjectSerializer* GetObjectSerializer() const { return GObjectSerializer; }
 
     template <class T = UObject>
-    TObjectPtr<T> DownloadWrapper(TObjectPtr<T> InObject, FString Type, FString Name, FString Path);
+    static TObjectPtr<T> DownloadWrapper(TObjectPtr<T> InObject, FString Type, FString Name, FString Path);
 
 protected:
     UPropertySerializer* PropertySerializer;
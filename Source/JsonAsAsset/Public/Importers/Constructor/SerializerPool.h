@@ -0,0 +1,33 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UObjectSerializer;
+
+/*
+ * Object and property serializers for importers to borrow.
+ *
+ * Every importer used to create a fresh pair and leave it behind. The pool hands out a pair
+ * that's been reset instead, and takes it back when the importer is destroyed, so a batch only
+ * creates as many pairs as importers are alive at once (one, plus one per nested reference).
+ */
+class JSONASASSET_API FJsonSerializerPool : public FGCObject {
+public:
+	static FJsonSerializerPool& Get();
+
+	/* An object serializer with its property serializer set */
+	UObjectSerializer* Acquire();
+
+	/* Resets Serializer and keeps it for the next importer */
+	void Release(UObjectSerializer* Serializer);
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	TArray<TObjectPtr<UObjectSerializer>> Free;
+	TArray<TObjectPtr<UObjectSerializer>> InUse;
+};
@@ -10,6 +10,7 @@
 #endif
 
 class UJsonAsAssetSettings;
+struct FScopedSlowTask;
 
 class FJsonAsAssetModule : public IModuleInterface
 {
@@ -20,6 +21,9 @@ public:
     // Executes File Dialog
     void PluginButtonClicked();
 
+    // Imports every file in a folder, files referenced by others first
+    void ImportFolder();
+
 private:
     UPROPERTY()
     UPropertySerializer* PropertySerializer;
@@ -34,6 +38,9 @@ private:
     void CreateLocalFetchDropdown(FMenuBuilder MenuBuilder) const;
     void ImportConvexCollision() const;
 
+    /* Imports Waves in order as part of SlowTask, with the next PrefetchWindow files parsing meanwhile. Returns how many were imported before a cancel */
+    static int32 ImportFiles(const TArray<TArray<FString>>& Waves, FScopedSlowTask& SlowTask, int32 PrefetchWindow = 0);
+
     bool bActionRequired = false;
     UJsonAsAssetSettings* Settings = nullptr;
 
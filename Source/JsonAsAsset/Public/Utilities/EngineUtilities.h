@@ -12,6 +12,9 @@
 #include "ContentBrowserModule.h"
 #include "IDesktopPlatform.h"
 #include "AssetUtilities.h"
+#include "JsonUtilities.h"
+#include "JsonEnumCache.h"
+#include "JsonStreamReader.h"
 #include "TlHelp32.h"
 #include "Json.h"
 
@@ -87,7 +90,7 @@ T* GetSelectedAsset(bool SupressErrors = false) {
 template <typename TEnum> 
 TEnum StringToEnum(const FString& StringValue)
 {
-	return StaticEnum<TEnum>() ? static_cast<TEnum>(StaticEnum<TEnum>()->GetValueByNameString(StringValue)) : TEnum();
+	return StaticEnum<TEnum>() ? FJsonEnumCache::Get().GetValue<TEnum>(StringValue) : TEnum();
 }
 
 inline TSharedPtr<FJsonObject> FindExport(const TSharedPtr<FJsonObject>& Export, const TArray<TSharedPtr<FJsonValue>>& File)
@@ -217,9 +220,8 @@ inline bool IsProcessRunning(const FString& ProcessName) {
 	return bIsRunning;
 }
 
-inline TSharedPtr<FJsonObject> GetExport(const FJsonObject* PackageIndex, TArray<TSharedPtr<FJsonValue>> AllJsonObjects) {
+inline TSharedPtr<FJsonObject> GetExport(const FJsonObject* PackageIndex, const FExportIndex& Exports) {
 	FString ObjectName = PackageIndex->GetStringField(TEXT("ObjectName")); // Class'Asset:ExportName'
-	FString ObjectPath = PackageIndex->GetStringField(TEXT("ObjectPath")); // Path/Asset.Index
 	FString Outer;
 	
 	// Clean up ObjectName (Class'Asset:ExportName' --> Asset:ExportName --> ExportName)
@@ -238,33 +240,9 @@ inline TSharedPtr<FJsonObject> GetExport(const FJsonObject* PackageIndex, TArray
 		ObjectName.Split(".", &Outer, &ObjectName);
 	}
 
-	int Index = 0;
+	const int32 Index = Exports.FindExport(ObjectName, Outer);
 
-	// Search for the object in the AllJsonObjects array
-	for (const TSharedPtr<FJsonValue>& Value : AllJsonObjects) {
-		const TSharedPtr<FJsonObject> ValueObject = Value->AsObject();
-
-		FString Name;
-		if (ValueObject->TryGetStringField(TEXT("Name"), Name) && Name == ObjectName) {
-			if (ValueObject->HasField(TEXT("Outer")) && !Outer.IsEmpty())
-			{
-				FString OuterName = ValueObject->GetStringField(TEXT("Outer"));
-
-				if (OuterName == Outer)
-				{
-					return AllJsonObjects[Index]->AsObject();
-				}
-			}
-			else
-			{
-				return ValueObject;
-			}
-		}
-
-		Index++;
-	}
-
-	return nullptr;
+	return Index != INDEX_NONE ? Exports.GetObject(Index) : nullptr;
 }
 
 inline bool IsProperExportData(const TSharedPtr<FJsonObject>& JsonObject)
@@ -282,22 +260,7 @@ inline bool IsProperExportData(const TSharedPtr<FJsonObject>& JsonObject)
 inline bool DeserializeJSON(const FString& FilePath, TArray<TSharedPtr<FJsonValue>>& JsonParsed)
 {
 	if (FPaths::FileExists(FilePath)) {
-
-		FString ContentBefore;
-		if (FFileHelper::LoadFileToString(ContentBefore, *FilePath)) {
-			FString Content = FString(TEXT("{\"data\": "));
-			Content.Append(ContentBefore);
-			Content.Append(FString("}"));
-
-			const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Content);
-
-			TSharedPtr<FJsonObject> JsonObject;
-			if (FJsonSerializer::Deserialize(JsonReader, JsonObject)) {
-				JsonParsed = JsonObject->GetArrayField(TEXT("data"));
-			
-				return true;
-			}
-		}
+		return FJsonStreamReader::LoadArrayFile(FilePath, JsonParsed);
 	}
 
 	return false;
@@ -422,6 +385,9 @@ inline auto AppendNotification(const FText& Text, const FText& SubText, const fl
                                const SNotificationItem::ECompletionState CompletionState, const bool bUseSuccessFailIcons,
                                const float WidthOverride) -> void
 {
+	// Nothing to show them on when running headless
+	if (IsRunningCommandlet()) return;
+
 	FNotificationInfo Info = FNotificationInfo(Text);
 	Info.ExpireDuration = ExpireDuration;
 	Info.bUseLargeFont = true;
@@ -441,6 +407,8 @@ inline auto AppendNotification(const FText& Text, const FText& SubText, float Ex
                                const FSlateBrush* SlateBrush, SNotificationItem::ECompletionState CompletionState,
                                const bool bUseSuccessFailIcons, const float WidthOverride) -> void
 {
+	if (IsRunningCommandlet()) return;
+
 	FNotificationInfo Info = FNotificationInfo(Text);
 	Info.ExpireDuration = ExpireDuration;
 	Info.bUseLargeFont = true;
@@ -0,0 +1,136 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "Dom/JsonObject.h"
+#include "Utilities/JsonStreamReader.h"
+
+/* Bump allocator, nothing is freed until Reset */
+class JSONASASSET_API FJsonArena {
+public:
+	FJsonArena() = default;
+	~FJsonArena();
+
+	FJsonArena(const FJsonArena&) = delete;
+	FJsonArena& operator=(const FJsonArena&) = delete;
+
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	template <typename T>
+	T* AllocateArray(const int32 Num) {
+		return Num > 0 ? static_cast<T*>(Allocate(sizeof(T) * Num, alignof(T))) : nullptr;
+	}
+
+	/* Frees every block at once */
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const { return AllocatedSize; }
+
+private:
+	static constexpr SIZE_T BlockSize = 256 * 1024;
+
+	TArray<uint8*> Blocks;
+
+	uint8* Cursor = nullptr;
+	uint8* BlockEnd = nullptr;
+
+	SIZE_T AllocatedSize = 0;
+};
+
+enum class EJsonArenaType : uint8 {
+	Null,
+	Boolean,
+	Number,
+	String,
+	Array,
+	Object
+};
+
+struct FJsonArenaField;
+
+/*
+ * Read-only JSON value living in an FJsonArena. Strings are null-terminated TCHAR, arrays hold
+ * their elements inline and objects hold their fields sorted by interned key.
+ *
+ * FNames ignore case, so fields also keep their key as written. Keys that only differ in case
+ * stay separate fields, a key written twice with the same case keeps the last value.
+ */
+struct JSONASASSET_API FJsonArenaNode {
+	EJsonArenaType Type = EJsonArenaType::Null;
+
+	/* Length of a string, or the number of elements or fields */
+	int32 Num = 0;
+
+	union {
+		bool bBoolean;
+		double Number;
+		const TCHAR* String;
+		const FJsonArenaNode* Elements;
+		const FJsonArenaField* Fields;
+	};
+
+	FJsonArenaNode() : Number(0) {}
+
+	bool IsNull() const { return Type == EJsonArenaType::Null; }
+	bool IsObject() const { return Type == EJsonArenaType::Object; }
+	bool IsArray() const { return Type == EJsonArenaType::Array; }
+
+	bool AsBool() const { return Type == EJsonArenaType::Boolean && bBoolean; }
+	double AsNumber() const { return Type == EJsonArenaType::Number ? Number : 0.0; }
+	FString AsString() const { return Type == EJsonArenaType::String ? FString(Num, String) : FString(); }
+
+	TArrayView<const FJsonArenaNode> GetElements() const;
+	TArrayView<const FJsonArenaField> GetFields() const;
+
+	/*
+	 * Binary search over the sorted fields, nullptr if this isn't an object or the key is missing.
+	 * When keys differ only in case, only the one written exactly like Key is found.
+	 */
+	const FJsonArenaNode* Find(FName Key) const;
+
+	bool TryGetString(FName Key, FString& OutString) const;
+};
+
+struct FJsonArenaField {
+	/* Interned for lookups, case-insensitive */
+	FName Key;
+
+	/* The key as written in the file, null-terminated */
+	const TCHAR* KeyText = nullptr;
+	int32 KeyLength = 0;
+
+	FJsonArenaNode Value;
+
+	FString GetKey() const { return FString(KeyLength, KeyText); }
+};
+
+/*
+ * A whole export file parsed into an arena, freed in one call by Reset or on destruction.
+ *
+ * Only meant for reading part of a file: the references FJsonImportPipeline::FindReferences
+ * sorts by, the BodySetup ImportConvexCollision needs. Importers, the object serializer and
+ * FJsonImportPlan stay on the engine DOM. FJsonObject is a concrete class whose fields are a
+ * TMap of shared values, nothing can stand in for it without building one, so a view over the
+ * arena would cost the same copy ToJsonValue/ToJsonObject make (the node and everything under
+ * it). Those are only worth it when the node is a small part of the file.
+ */
+class JSONASASSET_API FJsonArenaDocument {
+public:
+	/* Parses a root array from UTF-8 data, replacing anything parsed before */
+	bool Parse(const uint8* Data, int64 Size, FString* OutError = nullptr, EJsonReaderBackend Backend = EJsonReaderBackend::Default);
+	bool ParseFile(const FString& FilePath, FString* OutError = nullptr);
+
+	/* The root array, Null until something was parsed */
+	const FJsonArenaNode& GetRoot() const { return Root; }
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const { return Arena.GetAllocatedSize(); }
+
+	static TSharedPtr<FJsonValue> ToJsonValue(const FJsonArenaNode& Node);
+	static TSharedPtr<FJsonObject> ToJsonObject(const FJsonArenaNode& Node);
+
+private:
+	FJsonArena Arena;
+	FJsonArenaNode Root;
+};
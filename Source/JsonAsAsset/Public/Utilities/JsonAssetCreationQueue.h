@@ -0,0 +1,47 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/*
+ * Tells the editor about imported assets: the asset registry, loading the rest of the package,
+ * and bringing the content browser to the asset.
+ *
+ * Outside of a session that happens as each asset is created. During one it's held back until
+ * the outermost session ends, every asset and package is handled once, and the content browser
+ * syncs once to the roots (the assets of the files that were asked for, not their dependencies).
+ */
+class JSONASASSET_API FJsonAssetCreationQueue {
+public:
+	static FJsonAssetCreationQueue& Get();
+
+	/* Sessions nest, only the outermost one flushes */
+	void BeginSession();
+	void EndSession();
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	/* Registers the assets added so far without ending the session, before anything may unload them */
+	void Flush();
+
+	/* An asset was created, bSyncBrowser when it's something the user should be shown */
+	void Add(UObject* Asset, bool bSyncBrowser = true);
+
+	/* The last asset added since the previous call is the one a requested file imported */
+	void MarkRoot();
+
+private:
+	static void SyncBrowser(const TArray<UObject*>& InAssets);
+
+	int32 SessionDepth = 0;
+
+	TArray<TWeakObjectPtr<UObject>> Assets;
+
+	/* Index into Assets of the last syncable asset, and of the last one marked */
+	int32 LastSyncable = INDEX_NONE;
+	int32 LastRoot = INDEX_NONE;
+
+	TArray<TWeakObjectPtr<UObject>> Roots;
+};
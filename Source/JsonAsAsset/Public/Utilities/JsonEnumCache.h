@@ -0,0 +1,34 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Enum values by name, for the strings CUE4Parse writes for enums.
+ *
+ * UEnum::GetValueByNameString compares the string against every name of the enum, and it ran
+ * for every key of a curve table and every enum property. Native enums get a table from short
+ * name to value the first time they're seen (the ones importers always hit are built up front).
+ * Names that aren't in it, redirects for example, and enums that can change while the editor is
+ * running (user defined ones) still go through GetValueByNameString.
+ */
+class JSONASASSET_API FJsonEnumCache {
+public:
+	static FJsonEnumCache& Get();
+
+	/* Value of Name ("Value" or "EEnum::Value") in Enum, INDEX_NONE if there's no such name */
+	int64 GetValue(const UEnum* Enum, const FString& Name);
+
+	template <typename TEnum>
+	TEnum GetValue(const FString& Name) {
+		return static_cast<TEnum>(GetValue(StaticEnum<TEnum>(), Name));
+	}
+
+private:
+	FJsonEnumCache();
+
+	const TMap<FName, int64>& GetTable(const UEnum* Enum);
+
+	TMap<const UEnum*, TMap<FName, int64>> Tables;
+};
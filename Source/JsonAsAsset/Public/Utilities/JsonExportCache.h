@@ -0,0 +1,46 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "Dom/JsonValue.h"
+
+/*
+ * Binary copies of parsed export files, kept in Saved/JsonAsAsset/ExportCache.
+ *
+ * A cache file remembers the size, modification time and hash of the JSON it was made from.
+ * It's used as long as the size and time match, if only the time changed the JSON is hashed
+ * again and the cache is kept when the contents turn out to be the same.
+ */
+class JSONASASSET_API FJsonExportCache {
+public:
+	/* Size and modification time of a file, Size is -1 when there's no such file */
+	struct FStamp {
+		int64 Size = -1;
+		int64 Ticks = 0;
+	};
+
+	/* Set by the JsonAsAsset.ExportCache console variable */
+	static bool IsEnabled();
+
+	static FStamp GetStamp(const FString& FilePath);
+
+	/* Loads the exports cached for a file, false if there are none or the file changed since */
+	static bool Load(const FString& FilePath, TArray<TSharedPtr<FJsonValue>>& OutElements);
+
+	/*
+	 * Caches the exports parsed from a file, Data being the UTF-8 they were parsed from.
+	 * Stamp has to be taken before the file was read, a change made while reading then shows up as a newer time.
+	 */
+	static void Save(const FString& FilePath, const FStamp& Stamp, const uint8* Data, int64 Size, const TArray<TSharedPtr<FJsonValue>>& Elements);
+
+	/* Deletes the cache file of an export file that was removed */
+	static void Forget(const FString& FilePath);
+
+	/* Deletes cache files whose export file is gone, deleted or renamed, and leftovers of interrupted writes */
+	static void Prune();
+
+	/* Deletes every cache file */
+	static void Clear();
+
+	static FString GetCacheDirectory();
+};
@@ -0,0 +1,116 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/DateTime.h"
+
+#include <atomic>
+
+struct FFileChangeData;
+
+struct FJsonExportManifestEntry {
+	FString FilePath;
+	int64 Size = 0;
+	FDateTime Timestamp;
+
+	/* Type of every export in the file, filled in by a second pass over the files */
+	TArray<FName> Types;
+	bool bScanned = false;
+};
+
+/*
+ * Every export file under the export directory, keyed by its path relative to it without the
+ * extension (CodeName/Content/Path/Asset), so resolving a reference is a map lookup instead of a
+ * trip to the disk.
+ *
+ * The manifest is built on a worker thread and kept up to date by a directory watcher. Lookups
+ * made before it's ready, or while the export directory setting points somewhere else, fall back
+ * to checking the disk. Files the watcher reports are only stat'ed on the game thread, their
+ * types are read on a worker.
+ */
+class JSONASASSET_API FJsonExportManifest {
+public:
+	static FJsonExportManifest& Get();
+
+	/* Starts the first build and watches the export directory, called on module startup */
+	void Initialize();
+	void Shutdown();
+
+	/* Throws away the manifest and builds it again in the background */
+	void Rebuild();
+
+	bool IsReady() const { return bReady; }
+
+	/* File paths are still being listed */
+	bool IsBuilding() const;
+
+	/* Rebuilds if the export directory setting changed since the last build */
+	void Refresh();
+
+	/* Blocks until file paths are known (types may still be scanning), false if nothing is being built */
+	bool WaitUntilReady() const;
+
+	/* Full path of the export file at RelativePath, false if there is none */
+	bool FindFile(const FString& RelativePath, FString& OutFilePath);
+
+	bool FindEntry(const FString& RelativePath, FJsonExportManifestEntry& OutEntry) const;
+
+	/* Relative paths of the files exporting an object of Type, only covers files scanned so far */
+	TArray<FString> FindByType(FName Type) const;
+
+	/* The export directory setting as a full, normalized path, empty when it isn't set */
+	static FString GetExportDirectory();
+
+private:
+	/* A file whose types still have to be read */
+	struct FPendingScan {
+		FString RelativePath;
+		FString FilePath;
+		FDateTime Timestamp;
+	};
+
+	void Build(FString Directory, int32 BuildGeneration);
+	void OnDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+	/* Changes heard while a build was listing the directory, applied once it's done */
+	void ApplyDeferredChanges(int32 BuildGeneration);
+
+	/* Scans on a worker, one task drains the queue */
+	void QueueScan(FPendingScan&& Scan);
+	void ScanPending();
+
+	/* Keeps the types unless the entry was replaced or removed meanwhile */
+	void SetTypes(const FString& RelativePath, const FDateTime& Timestamp, TArray<FName>&& Types);
+
+	void Watch(const FString& Directory);
+	void Unwatch();
+
+	static FString MakeRelativePath(const FString& Directory, const FString& FilePath);
+	static void ScanTypes(const FString& FilePath, TArray<FName>& OutTypes);
+
+	mutable FRWLock Lock;
+
+	TMap<FString, FJsonExportManifestEntry> Entries;
+	FString Root;
+
+	/* Bumped by every rebuild, a build that sees it change gives up */
+	FThreadSafeCounter Generation;
+	TFuture<void> BuildTask;
+
+	std::atomic<bool> bReady { false };
+
+	/* Guarded by Lock */
+	bool bBuilding = false;
+	bool bDeferredRescan = false;
+	TSet<FString> DeferredFiles;
+
+	TArray<FPendingScan> PendingScans;
+	bool bScanning = false;
+	TFuture<void> ScanTask;
+
+	FString WatchedDirectory;
+	FDelegateHandle WatcherHandle;
+};
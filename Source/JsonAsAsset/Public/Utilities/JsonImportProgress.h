@@ -0,0 +1,69 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/TokenizedMessage.h"
+
+class SNotificationItem;
+
+enum class EJsonImportEvent : uint8 {
+	Imported,
+	ImportFailed,
+	Downloaded,
+	DownloadFailed
+};
+
+/*
+ * What the user sees while assets are imported.
+ *
+ * Outside of a session every asset gets a toast and a message log line right away, like it always
+ * did. During a session a single notification shows counts by type, throughput and time left,
+ * assets only get toasts of their own until JsonAsAsset.MaxImportToasts is reached, and the
+ * message log lines are written together when the session ends, a page for each file.
+ */
+class JSONASASSET_API FJsonImportProgress {
+public:
+	static FJsonImportProgress& Get();
+
+	/* Sessions nest, the outermost one owns the notification. NumFiles is used for the time left */
+	void BeginSession(int32 NumFiles);
+	void EndSession();
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	/* An asset was imported or downloaded, or failed to */
+	void Record(EJsonImportEvent Event, const FString& Type, const FString& Name);
+
+	/* Assets recorded until FinishFile go on File's page of the message log */
+	void BeginFile(const FString& File);
+
+	/* A file of the session is done, whatever happened to its assets */
+	void FinishFile();
+
+private:
+	static void ShowToast(EJsonImportEvent Event, const FString& Type, const FString& Name);
+	static TSharedRef<FTokenizedMessage> MakeMessage(EJsonImportEvent Event, const FString& Type, const FString& Name);
+
+	void UpdateNotification(bool bForce);
+	FText GetSummary() const;
+
+	int32 SessionDepth = 0;
+
+	int32 NumFiles = 0;
+	int32 NumFilesDone = 0;
+	int32 NumAssets = 0;
+	int32 NumFailed = 0;
+
+	double StartTime = 0.0;
+	double LastUpdateTime = 0.0;
+
+	/* Assets per type, failures included */
+	TMap<FString, int32> CountsByType;
+
+	FString CurrentFile;
+
+	/* Message log lines and the file they were recorded for, in the order they happened */
+	TArray<TPair<FString, TSharedRef<FTokenizedMessage>>> Messages;
+	TSharedPtr<SNotificationItem> Notification;
+};
@@ -0,0 +1,54 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+/*
+ * Keeps imported assets and the objects used to build them alive while an import is running,
+ * instead of rooting them for the rest of the editor's life.
+ *
+ * During a session everything kept is referenced from here and let go when a dependency wave
+ * finishes or the session ends, and the packages the wave queued are saved right then. Assets
+ * stay around afterwards like any other asset in the editor (they're standalone), factories and
+ * other intermediates can be collected.
+ *
+ * With JsonAsAsset.GCBetweenWaves set, garbage is collected between waves once that many files
+ * were imported since the last collection. Before that, assets whose package was saved and that
+ * aren't open in an editor stop being standalone, later waves load them back from disk when they
+ * need them. Assets that couldn't be saved (or weren't, with saving on import off) stay loaded,
+ * and whatever the collection didn't unload (still referenced elsewhere) is standalone again.
+ */
+class JSONASASSET_API FJsonImportReferences : public FGCObject {
+public:
+	static FJsonImportReferences& Get();
+
+	/* Sessions nest, only the outermost one lets go */
+	void BeginSession();
+	void EndSession();
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	/* Keeps Object alive until the wave or session ends, outside of a session it's rooted like before */
+	void Keep(UObject* Object);
+
+	/* A wave of NumFiles files was imported, saves what it queued, files of later waves only load what it saved or left in memory */
+	void FinishWave(int32 NumFiles);
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	/* Lets saved packages that nobody is editing be collected, returns the objects that stopped being standalone */
+	TArray<TWeakObjectPtr<UObject>> ReleaseSavedPackages();
+
+	int32 SessionDepth = 0;
+	int32 NumFilesSinceCollection = 0;
+
+	TArray<TObjectPtr<UObject>> Objects;
+
+	/* Packages of the assets kept since the last collection */
+	TSet<TWeakObjectPtr<UPackage>> Packages;
+};
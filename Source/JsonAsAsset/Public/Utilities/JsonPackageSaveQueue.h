@@ -0,0 +1,69 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+struct FJsonPackageSaveResult {
+	FString PackageName;
+	bool bSaved = false;
+
+	/* Time spent saving this package, 0 when the batch was saved concurrently */
+	double Seconds = 0.0;
+};
+
+struct FJsonPackageSaveReport {
+	int32 NumSaved = 0;
+	int32 NumFailed = 0;
+
+	bool bConcurrent = false;
+	double Seconds = 0.0;
+
+	/* In the order the packages were queued */
+	TArray<FJsonPackageSaveResult> Packages;
+};
+
+/*
+ * Saves the packages an import created. Outside of a session a package is saved right away like
+ * it always was, during one it's queued instead and every queued package is saved once when the
+ * outermost session ends. A package queued twice (a dependency pulled in by several files, a
+ * texture saved by its creator and again by the importer) is only saved once. The queue can be
+ * flushed during a session too, so a long import doesn't hold every package it made until the end.
+ *
+ * With JsonAsAsset.ConcurrentSave on UE5, the batch goes through UPackage::SaveConcurrent.
+ */
+class JSONASASSET_API FJsonPackageSaveQueue {
+public:
+	static FJsonPackageSaveQueue& Get();
+
+	/* Sessions nest, only the outermost one saves */
+	void BeginSession();
+
+	/* Saves the queued packages when the outermost session ends, the report covers the whole session and is empty otherwise */
+	FJsonPackageSaveReport EndSession();
+
+	/* Saves the packages queued so far without ending the session, the report only covers those */
+	FJsonPackageSaveReport Flush();
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	/* Saves the package now, or when the session ends if there's one */
+	void Save(UPackage* Package);
+
+	/* Logs the report, one line per package at verbose */
+	static void LogReport(const FJsonPackageSaveReport& Report);
+
+private:
+	static bool SavePackage(UPackage* Package);
+
+	void AppendToSession(const FJsonPackageSaveReport& Report);
+
+	int32 SessionDepth = 0;
+
+	/* Everything flushed since the outermost session began */
+	FJsonPackageSaveReport SessionReport;
+
+	TArray<TWeakObjectPtr<UPackage>> Queued;
+	TSet<FName> QueuedNames;
+};
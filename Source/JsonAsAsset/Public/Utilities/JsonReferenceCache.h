@@ -0,0 +1,60 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+/* ObjectName and ObjectPath of a reference, cleaned up into something that can be loaded */
+struct FJsonReferenceName {
+	FString Type;
+	FString Name;
+	FString Path;
+
+	/* Set when Name was inside another object, e.g. a component of an actor */
+	FString Outer;
+};
+
+/*
+ * Remembers how references were resolved while an import is running.
+ *
+ * The same texture or parent material is usually referenced many times in one file, and each time
+ * the reference was parsed again and StaticLoadObject was asked again, failing lookups included.
+ * During a session the parsed names and the load results are kept, misses too, until an asset is
+ * imported into that package or the session ends. Outside of a session nothing is kept.
+ */
+class JSONASASSET_API FJsonReferenceCache {
+public:
+	static FJsonReferenceCache& Get();
+
+	/* Sessions nest, only the outermost one forgets */
+	void BeginSession();
+	void EndSession();
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	/* The names of a reference object (with ObjectName and ObjectPath fields) */
+	FJsonReferenceName Parse(const FJsonObject& Reference);
+
+	/* StaticLoadObject of a full object path, nullptr if it doesn't exist */
+	UObject* Load(const FString& ObjectPath);
+
+	/* An asset was imported into PackageName, what was known about it is out of date */
+	void Invalidate(const FString& PackageName);
+
+private:
+	static FJsonReferenceName ParseUncached(const FString& ObjectName, const FString& ObjectPath);
+
+	struct FLoadResult {
+		TWeakObjectPtr<UObject> Object;
+		bool bMissing = false;
+	};
+
+	int32 SessionDepth = 0;
+
+	TMap<TPair<FString, FString>, FJsonReferenceName> Names;
+
+	/* Package name to the objects looked up in it */
+	TMap<FString, TMap<FString, FLoadResult>> Packages;
+};
@@ -0,0 +1,80 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "Dom/JsonValue.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+enum class EJsonReaderBackend : uint8 {
+	/* Picked by the JsonAsAsset.StructuralIndexParser console variable, scalar unless it is set */
+	Default,
+
+	/* Byte by byte recursive descent */
+	Scalar,
+
+	/* Structural characters are located 64 bytes at a time first (SSE2 on x86), parsing then jumps between them */
+	StructuralIndex
+};
+
+/*
+ * Reads exported JSON files, whose root is an array of exports, straight from their UTF-8 bytes.
+ *
+ * Elements of the root array are handed over one by one as soon as they are parsed, so
+ * there's no need to wrap the file in an object or convert the whole of it to TCHAR first.
+ */
+class JSONASASSET_API FJsonStreamReader {
+public:
+	/* Called for every element of the root array, return false to stop reading */
+	typedef TFunctionRef<bool(const TSharedPtr<FJsonValue>& Element)> FOnElement;
+
+	/* Parses a root array from UTF-8 data (a leading BOM is skipped) */
+	static bool ReadArray(const uint8* Data, int64 Size, FOnElement OnElement, FString* OutError = nullptr, EJsonReaderBackend Backend = EJsonReaderBackend::Default);
+
+	/* Loads a file and parses its root array */
+	static bool ReadArrayFile(const FString& FilePath, FOnElement OnElement, FString* OutError = nullptr);
+
+	/* Loads a file and collects every element of its root array, going through FJsonExportCache */
+	static bool LoadArrayFile(const FString& FilePath, TArray<TSharedPtr<FJsonValue>>& OutElements, FString* OutError = nullptr);
+
+	/* Resolves Default to the backend selected by the console variable */
+	static bool UseStructuralIndex(EJsonReaderBackend Backend);
+};
+
+/*
+ * UTF-8 bytes of an export file. The file is memory mapped when the platform allows it, so the
+ * parser reads straight from the page cache: nothing is copied, and pages the parser has gone past
+ * are clean and can be dropped by the OS under pressure. Otherwise, and for UTF-16 files, which are
+ * converted, the bytes are held in memory.
+ */
+class JSONASASSET_API FJsonFileView {
+public:
+	FJsonFileView() = default;
+	~FJsonFileView();
+
+	FJsonFileView(const FJsonFileView&) = delete;
+	FJsonFileView& operator=(const FJsonFileView&) = delete;
+
+	bool Open(const FString& FilePath, FString* OutError = nullptr);
+
+	/* Unmaps or frees the contents */
+	void Reset();
+
+	const uint8* GetData() const { return Data; }
+	int64 Num() const { return Size; }
+
+	bool IsMapped() const { return Region.IsValid(); }
+
+private:
+	/* Declared before the region so that it outlives it */
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+
+	TArray<uint8> Buffer;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
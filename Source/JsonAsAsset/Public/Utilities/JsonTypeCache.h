@@ -0,0 +1,49 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/*
+ * Classes, enums and structs by name, for the places that only have a type name from the JSON.
+ *
+ * Finding them with ANY_PACKAGE walks every object of that type in memory, and it happened for
+ * every export, node and material expression. Names are looked up once and remembered, misses
+ * included. Everything is forgotten when modules load or unload and when objects are reinstanced
+ * (a recompiled Blueprint leaves its old class behind as REINST_), misses also when an asset is
+ * imported (it may be the enum or struct that was missing).
+ */
+class JSONASASSET_API FJsonTypeCache {
+public:
+	static FJsonTypeCache& Get();
+
+	/* Stops listening for module changes and reinstancing, called when the plugin shuts down */
+	void Shutdown();
+
+	template <typename T>
+	T* Find(const FString& Name) {
+		return static_cast<T*>(FindType(T::StaticClass(), Name));
+	}
+
+	/* Name resolved to Type some other way (a redirect), the next Find of Name returns it */
+	template <typename T>
+	void Remember(const FString& Name, T* Type) {
+		RememberType(T::StaticClass(), Name, Type);
+	}
+
+	void ForgetMisses();
+	void Reset();
+
+private:
+	UObject* FindType(UClass* TypeClass, const FString& Name);
+	void RememberType(UClass* TypeClass, const FString& Name, UObject* Type);
+
+	using FKey = TPair<const UClass*, FName>;
+
+	TMap<FKey, TWeakObjectPtr<UObject>> Types;
+	TSet<FKey> Misses;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ObjectsReplacedHandle;
+};
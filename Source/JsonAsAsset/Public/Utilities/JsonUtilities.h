@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
 struct FExportData {
 	FExportData(const FName Type, const FName Outer, const TSharedPtr<FJsonObject>& Json) {
 		this->Type = Type;
@@ -24,4 +27,141 @@ struct FExportData {
 	FName Type;
 	FName Outer;
 	FJsonObject* Json;
-};
\ No newline at end of file
+};
+
+/*
+ * Lookup tables over the exports of a single JSON file, built once per file.
+ * Replaces linear scans (and the FString copies that came with them) when resolving
+ * exports by name, outer or type.
+ */
+struct FExportIndex {
+	FExportIndex() {}
+
+	explicit FExportIndex(const TArray<TSharedPtr<FJsonValue>>& Exports) {
+		Build(Exports);
+	}
+
+	void Build(const TArray<TSharedPtr<FJsonValue>>& Exports) {
+		Values = Exports;
+		Entries.Reset(Exports.Num());
+		HasOuter.Reset(Exports.Num());
+		NameToIndices.Reset();
+		OuterAndNameToIndex.Reset();
+		OuterToIndices.Reset();
+		TypeToIndices.Reset();
+
+		for (int32 Index = 0; Index < Exports.Num(); Index++) {
+			const TSharedPtr<FJsonValue>& Value = Exports[Index];
+			const TSharedPtr<FJsonObject> Object = Value.IsValid() && Value->Type == EJson::Object ? Value->AsObject() : nullptr;
+
+			FString Type, Name, Outer;
+			bool bHasOuter = false;
+
+			if (Object.IsValid()) {
+				Object->TryGetStringField(TEXT("Type"), Type);
+				Object->TryGetStringField(TEXT("Name"), Name);
+				bHasOuter = Object->TryGetStringField(TEXT("Outer"), Outer);
+			}
+
+			const FExportData& Entry = Entries.Add_GetRef(FExportData(Type, bHasOuter ? Outer : TEXT("None"), Object.Get()));
+			HasOuter.Add(bHasOuter);
+
+			if (!Name.IsEmpty()) {
+				NameToIndices.FindOrAdd(FName(*Name)).Add(Index);
+			}
+
+			TypeToIndices.FindOrAdd(Entry.Type).Add(Index);
+
+			if (bHasOuter) {
+				OuterToIndices.FindOrAdd(Entry.Outer).Add(Index);
+
+				/* Keep the first match, like the scans this replaces */
+				OuterAndNameToIndex.FindOrAdd(TPair<FName, FName>(Entry.Outer, FName(*Name)), Index);
+			}
+		}
+	}
+
+	int32 Num() const { return Entries.Num(); }
+
+	const FExportData& GetData(const int32 Index) const { return Entries[Index]; }
+	const TSharedPtr<FJsonValue>& GetValue(const int32 Index) const { return Values[Index]; }
+	TSharedPtr<FJsonObject> GetObject(const int32 Index) const { return Values[Index]->AsObject(); }
+
+	/* Indices of exports named Name, in file order */
+	const TArray<int32>& FindByName(const FName Name) const {
+		return FindOrEmpty(NameToIndices, Name);
+	}
+
+	/* Indices of exports with the given Outer, in file order */
+	const TArray<int32>& FindByOuter(const FName Outer) const {
+		return FindOrEmpty(OuterToIndices, Outer);
+	}
+
+	/* Indices of exports with the given Type, in file order */
+	const TArray<int32>& FindByType(const FName Type) const {
+		return FindOrEmpty(TypeToIndices, Type);
+	}
+
+	/* Index of the first export named Name whose Outer is Outer, or INDEX_NONE */
+	int32 FindByOuterAndName(const FName Outer, const FName Name) const {
+		const int32* Index = OuterAndNameToIndex.Find(TPair<FName, FName>(Outer, Name));
+
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	/* Indices of exports whose Type starts with Prefix, in file order */
+	TArray<int32> FindByTypePrefix(const FString& Prefix) const {
+		TArray<int32> Result;
+
+		for (const TPair<FName, TArray<int32>>& Pair : TypeToIndices) {
+			if (!Pair.Key.IsNone() && Pair.Key.ToString().StartsWith(Prefix)) {
+				Result.Append(Pair.Value);
+			}
+		}
+
+		Result.Sort();
+		return Result;
+	}
+
+	/*
+	 * Resolves an export by name, restricted to Outer when one is given.
+	 * Exports without an Outer field match any Outer.
+	 */
+	int32 FindExport(const FString& Name, const FString& Outer) const {
+		const FName NameKey(*Name, FNAME_Find);
+		if (NameKey.IsNone()) return INDEX_NONE;
+
+		const TArray<int32>& Candidates = FindByName(NameKey);
+		if (Candidates.Num() == 0) return INDEX_NONE;
+
+		if (Outer.IsEmpty()) return Candidates[0];
+
+		/* An Outer name that was never made would look up None, only exports without an Outer can match it */
+		const FName OuterKey(*Outer, FNAME_Find);
+		const int32 ExactIndex = OuterKey.IsNone() ? INDEX_NONE : FindByOuterAndName(OuterKey, NameKey);
+
+		for (const int32 Candidate : Candidates) {
+			if (ExactIndex != INDEX_NONE && Candidate >= ExactIndex) return ExactIndex;
+			if (!HasOuter[Candidate]) return Candidate;
+		}
+
+		return INDEX_NONE;
+	}
+
+private:
+	static const TArray<int32>& FindOrEmpty(const TMap<FName, TArray<int32>>& Map, const FName Key) {
+		static const TArray<int32> Empty;
+		const TArray<int32>* Found = Map.Find(Key);
+
+		return Found ? *Found : Empty;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Values;
+	TArray<FExportData> Entries;
+	TArray<bool> HasOuter;
+
+	TMap<FName, TArray<int32>> NameToIndices;
+	TMap<TPair<FName, FName>, int32> OuterAndNameToIndex;
+	TMap<FName, TArray<int32>> OuterToIndices;
+	TMap<FName, TArray<int32>> TypeToIndices;
+};
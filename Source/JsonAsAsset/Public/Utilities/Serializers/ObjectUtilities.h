@@ -4,6 +4,7 @@
 
 #include "UObject/Object.h"
 #include "Json.h"
+#include "Utilities/JsonUtilities.h"
 #include "ObjectUtilities.generated.h"
 
 class UPropertySerializer;
@@ -49,9 +50,13 @@ private:
 public:
     UObjectSerializer();
 
-    TArray<TSharedPtr<FJsonValue>> AllObjectsReference;
+    /* Name/Outer/Type lookups over the exports of the file being imported, set by SetupExports */
+    TSharedPtr<const FExportIndex> ExportIndex;
 
-    void SetupExports(TArray<TSharedPtr<FJsonValue>> InObjects);
+    void SetupExports(const TSharedRef<const FExportIndex>& Index);
+
+    /* Exports already deserialized into the subobject they describe, subobjects can reference each other */
+    TSet<const FJsonObject*> DeserializedExports;
 
     TArray<FString> ExportsToNotDeserialize;
 
@@ -76,6 +81,9 @@ public:
     void DeserializeObjectProperties(const TSharedPtr<FJsonObject>& Properties, UObject* Object);
     void SetPropertySerializer(UPropertySerializer* NewPropertySerializer);
 
+    /* Forgets everything about the last import, for FJsonSerializerPool to hand it out again */
+    void ResetForReuse();
+
     void InitializeForSerialization(UPackage* NewSourcePackage);
 
     /**
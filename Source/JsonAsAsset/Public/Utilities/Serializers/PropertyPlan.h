@@ -0,0 +1,98 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/* The C++ type of a numeric property, None for everything else (enums included) */
+enum class EPropertyPlanNumber : uint8 {
+	None,
+	Float,
+	Double,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64
+};
+
+/* A property of a plan, with the name the JSON uses for it */
+struct FPropertyPlanEntry {
+	FProperty* Property;
+	FString Name;
+	EPropertyPlanNumber Number;
+
+	/* Written as PropertyName[Index] keys instead of a single field */
+	bool IsStaticArray() const { return Property->ArrayDim != 1; }
+};
+
+/*
+ * The properties of a UStruct (or UClass) that can be deserialized, worked out once.
+ *
+ * Walking PropertyLink meant making an FString of every property's name and checking its
+ * flags, for every struct instance, every row of a data table for example, even though most
+ * properties usually aren't in the JSON. A plan keeps the properties that pass the flag checks,
+ * findable by JSON key, so deserializing goes over the keys that are there.
+ *
+ * Plans of native types are kept for good. Blueprint classes and user defined structs can be
+ * recompiled or collected, theirs are kept by weak pointer and all forgotten whenever a
+ * Blueprint compiles, a user defined struct changes or objects are reinstanced.
+ */
+class JSONASASSET_API FPropertyPlan {
+public:
+	static TSharedRef<const FPropertyPlan> Get(const UStruct* Struct);
+
+	/* The non static array property a JSON key is for */
+	const FPropertyPlanEntry* Find(const FString& Key) const {
+		const int32* Index = ByName.Find(Key);
+		return Index != nullptr ? &Properties[*Index] : nullptr;
+	}
+
+	/* Position in GetStaticArrays of the static array property a name is for */
+	int32 FindStaticArray(const FString& Name) const {
+		const int32* Slot = StaticArraysByName.Find(Name);
+		return Slot != nullptr ? *Slot : INDEX_NONE;
+	}
+
+	const TArray<FPropertyPlanEntry>& GetProperties() const { return Properties; }
+	const TArray<int32>& GetStaticArrays() const { return StaticArrays; }
+
+	/* Every property is a plain number, a vector or color for example */
+	bool IsAllNumbers() const { return bAllNumbers; }
+
+	static EPropertyPlanNumber GetNumberType(const FProperty* Property);
+
+	/* Writes Number to Value the way SetFloatingPointPropertyValue/SetIntPropertyValue would */
+	static void SetNumber(const EPropertyPlanNumber Type, void* Value, const double Number) {
+		switch (Type) {
+			case EPropertyPlanNumber::Float: *static_cast<float*>(Value) = static_cast<float>(Number); break;
+			case EPropertyPlanNumber::Double: *static_cast<double*>(Value) = Number; break;
+			case EPropertyPlanNumber::Int8: *static_cast<int8*>(Value) = static_cast<int8>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::Int16: *static_cast<int16*>(Value) = static_cast<int16>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::Int32: *static_cast<int32*>(Value) = static_cast<int32>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::Int64: *static_cast<int64*>(Value) = static_cast<int64>(Number); break;
+			case EPropertyPlanNumber::UInt8: *static_cast<uint8*>(Value) = static_cast<uint8>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::UInt16: *static_cast<uint16*>(Value) = static_cast<uint16>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::UInt32: *static_cast<uint32*>(Value) = static_cast<uint32>(static_cast<int64>(Number)); break;
+			case EPropertyPlanNumber::UInt64: *static_cast<uint64*>(Value) = static_cast<uint64>(static_cast<int64>(Number)); break;
+			default: break;
+		}
+	}
+
+	/* Drops the plans of every type that isn't native */
+	static void ForgetNonNative();
+
+private:
+	explicit FPropertyPlan(const UStruct* Struct);
+
+	TArray<FPropertyPlanEntry> Properties;
+	TMap<FString, int32> ByName;
+	TArray<int32> StaticArrays;
+	TMap<FString, int32> StaticArraysByName;
+
+	bool bAllNumbers;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ObjectUtilities.h"
+#include "PropertyPlan.h"
 #include "Dom/JsonObject.h"
 #include "UObject/Object.h"
 #include "UObject/UnrealType.h"
@@ -100,6 +101,12 @@ public:
 	/** Checks whenever we should serialize property in question at all */
 	bool ShouldSerializeProperty(FProperty* Property) const;
 
+	/** The flag checks of ShouldSerializeProperty, the same for every serializer */
+	static bool IsSerializableProperty(const FProperty* Property);
+
+	/** Deserializes the properties of Struct found in Properties into Container, except IgnoredProperty */
+	void DeserializeProperties(const UStruct* Struct, void* Container, const TSharedPtr<FJsonObject>& Properties, FName IgnoredProperty = NAME_None);
+
 	TSharedRef<FJsonValue> SerializePropertyValue(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
 	TSharedRef<FJsonObject> SerializeStruct(UScriptStruct* Struct, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
 
@@ -112,65 +119,39 @@ public:
 
 private:
 	FStructSerializer* GetStructSerializer(UScriptStruct* Struct) const;
+
+	/** Array fast paths, Data holds Elements.Num() initialized values */
+	static void DeserializeNumberArray(EPropertyPlanNumber Type, const TArray<TSharedPtr<FJsonValue>>& Elements, void* Data);
+	static void DeserializeNumberStruct(const FPropertyPlan& Plan, const FJsonObject& Object, void* StructData);
 	bool ComparePropertyValuesInner(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context);
 	TSharedRef<FJsonValue> SerializePropertyValueInner(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects);
 };
 
-/* Use to handle differentiating formats produced by CUE4Parse */
-inline bool PassthroughPropertyHandler(FProperty* Property, const FString& PropertyName, void* PropertyValue, const TSharedPtr<FJsonObject>& Properties, UPropertySerializer* PropertySerializer) {
-	/* Handles static arrays in the format of: PropertyName[Index] */
-	if (Property->ArrayDim != 1) {
-		TArray<TSharedPtr<FJsonValue>> ArrayElements;
-
-		/* Finds array elements with the format: PropertyName[Index] and sets them properly into an array */
-		for (const auto& Pair : Properties->Values) {
-			const FString& Key = Pair.Key;
-			TSharedPtr<FJsonValue> Value = Pair.Value;
-
-			/* If it doesn't start with the same property name */
-			if (!Key.StartsWith(PropertyName)) continue;
-
-			/* By default, it should be 0 */
-			int32 CurrentArrayIndex = 0;
+/* Splits a static array key, PropertyName[Index], keys without an index are element 0 */
+inline void SplitStaticArrayKey(const FString& Key, FString& OutName, int32& OutIndex) {
+	int32 OpenBracketPos;
 
-			/* If it is formatted like PropertyName[Index] */
-			if (Key.Contains("[") && Key.Contains("]")) {
-				int32 OpenBracketPos, CloseBracketPos;
-
-				/* Find the index in PropertyName[Index] (integer) */
-				if (Key.FindChar('[', OpenBracketPos) && Key.FindChar(']', CloseBracketPos) && CloseBracketPos > OpenBracketPos) {
-					FString IndexStr = Key.Mid(OpenBracketPos + 1, CloseBracketPos - OpenBracketPos - 1);
-					
-					CurrentArrayIndex = FCString::Atoi(*IndexStr);
-				}
-			}
-
-			/* Fail-save? */
-			if (CurrentArrayIndex >= ArrayElements.Num()) {
-				ArrayElements.SetNum(CurrentArrayIndex + 1);
-			}
-			
-			ArrayElements[CurrentArrayIndex] = Value;
-		}
-
-		/* Array elements is filled up, now we set them in the property value */
-		for (int32 ArrayIndex = 0; ArrayIndex < ArrayElements.Num(); ArrayIndex++) {
-			uint8* ArrayPropertyValue = static_cast<uint8*>(PropertyValue) + Property->ElementSize * ArrayIndex;
+	if (Key.Len() > 2 && Key[Key.Len() - 1] == ']' && Key.FindChar('[', OpenBracketPos)) {
+		OutName = Key.Left(OpenBracketPos);
+		OutIndex = FCString::Atoi(*Key + OpenBracketPos + 1);
+	} else {
+		OutName = Key;
+		OutIndex = 0;
+	}
+}
 
-			if (!ArrayElements.IsValidIndex(ArrayIndex)) continue;
+/* Sets the elements of a static array property, Elements are indexed like the property */
+inline void DeserializeStaticArray(FProperty* Property, const TArray<TSharedPtr<FJsonValue>>& Elements, void* PropertyValue, UPropertySerializer* PropertySerializer) {
+	const int32 NumElements = FMath::Min(Elements.Num(), Property->ArrayDim);
 
-			TSharedPtr<FJsonValue> ArrayJsonElement = ArrayElements[ArrayIndex];
+	for (int32 ArrayIndex = 0; ArrayIndex < NumElements; ArrayIndex++) {
+		const TSharedPtr<FJsonValue>& ArrayJsonElement = Elements[ArrayIndex];
 
-			/* Check to see if it's null */
-			if (ArrayJsonElement == nullptr || ArrayJsonElement->IsNull()) continue;
-			
-			const TSharedRef<FJsonValue> ArrayJsonValue = ArrayJsonElement.ToSharedRef();
+		/* Check to see if it's null */
+		if (ArrayJsonElement == nullptr || ArrayJsonElement->IsNull()) continue;
 
-			PropertySerializer->DeserializePropertyValueInner(Property, ArrayJsonValue, ArrayPropertyValue);
-		}
+		uint8* ArrayPropertyValue = static_cast<uint8*>(PropertyValue) + Property->ElementSize * ArrayIndex;
 
-		return true;
+		PropertySerializer->DeserializePropertyValueInner(Property, ArrayJsonElement.ToSharedRef(), ArrayPropertyValue);
 	}
-
-	return false;
-}
\ No newline at end of file
+}
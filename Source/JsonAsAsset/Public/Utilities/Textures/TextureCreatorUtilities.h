@@ -31,6 +31,9 @@ public:
 private:
 	static void GetDecompressedTextureData(uint8* Data, uint8*& OutData, const int SizeX, const int SizeY, const int SizeZ, const int TotalSize, const EPixelFormat Format);
 
+	/* Decodes a detex supported format in parallel bands of block rows. ASTC uses the 4x4 texture format with the given block footprint */
+	static void DecompressTextureParallel(const uint8* Data, uint8* OutData, const int SizeX, const int SizeY, const uint32 TextureFormat, const uint32 PixelFormat, const int BlockSizeX = 4, const int BlockSizeY = 4);
+
 protected:
 	FString FileName;
 	FString FilePath;